@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    BandCountBenchmark.cpp
+    Created: 17 Oct 2026 5:31:14pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/BandSplitter.h"
+
+/* BandSplitter cost against band count, in stereo and 8 channels, fed white noise at 48 kHz in the
+   64-sample sub-blocks the processor uses. %core is the share of one core needed to keep up in real time */
+//==============================================================================
+void Benchmarks::bandCount()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 8192, subBlockSize = 64;
+    constexpr int numRuns = 300;
+
+    std::cout << "bands  stages   2 ch ns/frame  %core   8 ch ns/frame  %core" << std::endl;
+
+    for (int numBands = BandSplitter<float>::minBands; numBands <= BandSplitter<float>::maxBands; ++numBands)
+    {
+        juce::String row;
+        int numStages = 0;
+
+        for (auto numChannels : { 2, 8 })
+        {
+            juce::AudioBuffer<float> input(numChannels, numSamples);
+            juce::Random random(1);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    input.setSample(channel, i, random.nextFloat() - 0.5f);
+
+            BandSplitter<float> splitter;
+            splitter.setNumBands(numBands);
+            splitter.prepare({ sampleRate, (juce::uint32)subBlockSize, (juce::uint32)numChannels });
+            numStages = splitter.getNumFilterStages();
+
+            auto ms = fastestRunMs(numRuns, [&]
+            {
+                for (int start = 0; start < numSamples; start += subBlockSize)
+                {
+                    juce::AudioBuffer<float> subBlock(input.getArrayOfWritePointers(), numChannels, start, subBlockSize);
+                    splitter.process(subBlock);
+                }
+            });
+
+            auto nsPerFrame = ms * 1.0e6 / numSamples;
+            auto shareOfCore = nsPerFrame * 1.0e-9 * sampleRate * 100.0;
+
+            row << juce::String(nsPerFrame, 1).paddedLeft(' ', 16) << juce::String(shareOfCore, 2).paddedLeft(' ', 7);
+        }
+
+        std::cout << juce::String(numBands).paddedLeft(' ', 5) << juce::String(numStages).paddedLeft(' ', 8) << row << std::endl;
+    }
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 17 Oct 2026 4:12:36pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <iostream>
+
+/* Standalone timings of the plugin's hot paths, built against the same sources as the plugin.
+   Each benchmark prints its own table. Build Release: the numbers mean nothing unoptimised */
+namespace Benchmarks
+{
+    void spectrumPaint();
+    void lfoRead();
+    void crossoverTraffic();
+    void bandCount();
+    void samplePrecision();
+    void waveTables();
+
+    /* Fastest of numRuns calls to run, in milliseconds. The fastest run is the one least disturbed
+       by the rest of the machine, so it is the most repeatable figure on a busy system */
+    template <typename Function>
+    double fastestRunMs(int numRuns, Function&& run)
+    {
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < numRuns; ++i)
+        {
+            auto start = juce::Time::getMillisecondCounterHiRes();
+            run();
+            fastest = juce::jmin(fastest, juce::Time::getMillisecondCounterHiRes() - start);
+        }
+
+        return fastest;
+    }
+}
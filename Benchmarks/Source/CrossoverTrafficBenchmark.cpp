@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    CrossoverTrafficBenchmark.cpp
+    Created: 17 Oct 2026 5:02:51pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/BandSplitter.h"
+
+namespace
+{
+    /* The five filters of the original three-band crossover, run both ways applyCrossover() has run them.
+       Every pass adds what it reads and writes to the tally, so the counts follow the code rather than an estimate */
+    struct ThreeBandCrossover
+    {
+        using Filter = juce::dsp::LinkwitzRileyFilter<float>;
+        using FilterType = juce::dsp::LinkwitzRileyFilterType;
+
+        explicit ThreeBandCrossover(const juce::dsp::ProcessSpec& spec)
+        {
+            for (auto [filter, type, cutoff] : { std::make_tuple(&LP1, FilterType::lowpass, 500.f),
+                                                 std::make_tuple(&HP1, FilterType::highpass, 500.f),
+                                                 std::make_tuple(&AP2, FilterType::allpass, 1000.f),
+                                                 std::make_tuple(&LP2, FilterType::lowpass, 1000.f),
+                                                 std::make_tuple(&HP2, FilterType::highpass, 1000.f) })
+            {
+                filter->setType(type);
+                filter->setCutoffFrequency(cutoff);
+                filter->prepare(spec);
+            }
+
+            for (auto& band : bands)
+                band.setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+        }
+
+        /* applyCrossover() before user-004: the input copied into every band, then MIDS into HIGHS */
+        void processWithCopies(const juce::AudioBuffer<float>& input)
+        {
+            for (auto& band : bands)
+                copy(input, band);
+
+            filter(LP1, bands[0], bands[0]);
+            filter(AP2, bands[0], bands[0]);
+            filter(HP1, bands[1], bands[1]);
+            copy(bands[1], bands[2]);
+            filter(LP2, bands[1], bands[1]);
+            filter(HP2, bands[2], bands[2]);
+        }
+
+        /* applyCrossover() after user-004: each filter reads straight from its source */
+        void processOutOfPlace(const juce::AudioBuffer<float>& input)
+        {
+            filter(LP1, input, bands[0]);
+            filter(AP2, bands[0], bands[0]);
+            filter(HP1, input, bands[1]);
+            filter(HP2, bands[1], bands[2]);
+            filter(LP2, bands[1], bands[1]);
+        }
+
+        void filter(Filter& filter, const juce::AudioBuffer<float>& source, juce::AudioBuffer<float>& destination)
+        {
+            auto sourceBlock = juce::dsp::AudioBlock<const float>(source.getArrayOfReadPointers(),
+                                                                  (size_t)source.getNumChannels(),
+                                                                  (size_t)source.getNumSamples());
+            auto destinationBlock = juce::dsp::AudioBlock<float>(destination);
+
+            filter.process(juce::dsp::ProcessContextNonReplacing<float>(sourceBlock, destinationBlock));
+            count(source);
+        }
+
+        void copy(const juce::AudioBuffer<float>& source, juce::AudioBuffer<float>& destination)
+        {
+            destination.makeCopyOf(source, true);
+            count(source);
+        }
+
+        void count(const juce::AudioBuffer<float>& block)
+        {
+            auto bytes = (size_t)block.getNumChannels() * (size_t)block.getNumSamples() * sizeof(float);
+            bytesRead += bytes;
+            bytesWritten += bytes;
+        }
+
+        Filter LP1, HP1, AP2, LP2, HP2;
+        std::array<juce::AudioBuffer<float>, 3> bands;
+        size_t bytesRead{ 0 }, bytesWritten{ 0 };
+    };
+}
+
+/* Buffer traffic and time per block of the original three-band crossover, before and after user-004,
+   at 8 channels and 2048 samples. Today's BandSplitter is timed on the same block for comparison */
+//==============================================================================
+void Benchmarks::crossoverTraffic()
+{
+    constexpr int numChannels = 8, numSamples = 2048;
+    constexpr int numRuns = 200;
+    const juce::dsp::ProcessSpec spec{ 48000.0, (juce::uint32)numSamples, (juce::uint32)numChannels };
+
+    juce::AudioBuffer<float> input(numChannels, numSamples);
+    juce::Random random(1);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    auto toKiB = [](size_t bytes) { return juce::String((int)(bytes / 1024)).paddedLeft(' ', 6); };
+    auto toUs = [](double ms) { return juce::String(ms * 1000.0, 0).paddedLeft(' ', 8); };
+
+    std::cout << "                read KiB  written KiB  total KiB  us/block" << std::endl;
+
+    for (auto withCopies : { true, false })
+    {
+        ThreeBandCrossover crossover(spec);
+        auto process = [&] { withCopies ? crossover.processWithCopies(input) : crossover.processOutOfPlace(input); };
+
+        process();
+        auto bytesRead = crossover.bytesRead, bytesWritten = crossover.bytesWritten;
+        auto ms = fastestRunMs(numRuns, process);
+
+        std::cout << (withCopies ? "with copies    " : "out of place   ")
+                  << toKiB(bytesRead) << "     " << toKiB(bytesWritten) << "     " << toKiB(bytesRead + bytesWritten)
+                  << "  " << toUs(ms) << std::endl;
+    }
+
+    BandSplitter<float> splitter;
+    splitter.setNumBands(3);
+    splitter.prepare(spec);
+    splitter.setCrossoverFrequency(0, 500.f);
+    splitter.setCrossoverFrequency(1, 1000.f);
+    splitter.snapToTargets();
+
+    auto splitterMs = fastestRunMs(numRuns, [&] { splitter.process(input); });
+    std::cout << "BandSplitter                                           " << toUs(splitterMs) << std::endl;
+}
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+
+    LfoReadBenchmark.cpp
+    Created: 17 Oct 2026 4:40:05pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/LFO.h"
+
+namespace
+{
+    /* The read from the original applyAmplitudeModulation(): a float position over a table of
+       sampleRate / 2 entries, fmod for the index and again for the advance, and a checked read */
+    struct FmodReader
+    {
+        FmodReader(double sampleRate, float rate, float relativePhaseDegrees)
+        {
+            auto size = (int)(sampleRate / 2);
+
+            for (int i = 0; i < size; ++i)
+                waveTable.add(0.5f + 0.5f * std::sin(juce::MathConstants<float>::twoPi * (float)i / (float)size));
+
+            increment = rate / 2.f;
+            relativePhaseInSamples = relativePhaseDegrees / 360.f * (float)sampleRate;
+        }
+
+        float getNextSample()
+        {
+            auto size = (float)waveTable.size();
+            auto value = waveTable[(int)std::fmod(position + relativePhaseInSamples, size)];
+            position = std::fmod(position + increment, size);
+            return value;
+        }
+
+        juce::Array<float> waveTable;
+        float position{ 0.f }, increment{ 0.f }, relativePhaseInSamples{ 0.f };
+    };
+}
+
+/* One LFO read and phase advance, at 48 kHz and 3.7 Hz, in 4096-sample blocks. The LFO rows include
+   the depth, symmetry and invert shaping it applies at read time, which the original read didn't have */
+//==============================================================================
+void Benchmarks::lfoRead()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 4096;
+    constexpr int numRuns = 400;
+
+    std::vector<float> output((size_t)numSamples);
+    FmodReader fmodReader(sampleRate, 3.7f, 90.f);
+
+    LFO lfo;
+    lfo.setDsp(false);
+    lfo.setWaveDepth(50.f);
+    lfo.initializeLFO(sampleRate);
+    lfo.updateLFO(sampleRate, 120.0);
+
+    auto toNsPerSample = [](double ms) { return ms * 1.0e6 / numSamples; };
+
+    auto fmodMs = fastestRunMs(numRuns, [&]
+    {
+        for (auto& sample : output)
+            sample = fmodReader.getNextSample();
+    });
+
+    lfo.setInterpolation(LFO::Interpolation::linear);
+    auto linearMs = fastestRunMs(numRuns, [&] { lfo.renderBlock(output.data(), numSamples); });
+
+    lfo.setInterpolation(LFO::Interpolation::cubic);
+    auto cubicMs = fastestRunMs(numRuns, [&] { lfo.renderBlock(output.data(), numSamples); });
+
+    std::cout << "original fmod read          " << juce::String(toNsPerSample(fmodMs), 2) << " ns/sample" << std::endl
+              << "LFO::renderBlock, linear    " << juce::String(toNsPerSample(linearMs), 2) << " ns/sample" << std::endl
+              << "LFO::renderBlock, cubic     " << juce::String(toNsPerSample(cubicMs), 2) << " ns/sample" << std::endl;
+}
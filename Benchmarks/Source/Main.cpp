@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 4:12:36pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+
+/* Runs the benchmarks named on the command line, or all of them */
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const std::vector<std::pair<juce::String, std::function<void()>>> benchmarks
+    {
+        { "spectrum", Benchmarks::spectrumPaint },
+        { "lfo", Benchmarks::lfoRead },
+        { "crossover", Benchmarks::crossoverTraffic },
+        { "bands", Benchmarks::bandCount },
+        { "precision", Benchmarks::samplePrecision },
+        { "wavetables", Benchmarks::waveTables }
+    };
+
+    juce::StringArray requested;
+
+    for (int i = 1; i < argc; ++i)
+        requested.add(argv[i]);
+
+    for (auto& [name, run] : benchmarks)
+    {
+        if (requested.isEmpty() || requested.contains(name))
+        {
+            std::cout << "== " << name << " ==" << std::endl;
+            run();
+            std::cout << std::endl;
+        }
+    }
+
+    return 0;
+}
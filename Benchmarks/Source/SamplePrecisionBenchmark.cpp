@@ -0,0 +1,130 @@
+/*
+  ==============================================================================
+
+    SamplePrecisionBenchmark.cpp
+    Created: 17 Oct 2026 5:58:27pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/BandSplitter.h"
+#include "../../Source/DSP/LFO.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numSamples = 8192, subBlockSize = 64, numBands = 3;
+    constexpr int numRuns = 300;
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType> makeNoise(int numChannels)
+    {
+        juce::AudioBuffer<SampleType> noise(numChannels, numSamples);
+        juce::Random random(1);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                noise.setSample(channel, i, (SampleType)(random.nextFloat() - 0.5f));
+
+        return noise;
+    }
+
+    /* Nanoseconds per sample frame for one instantiation, at the given width:
+       the LFO alone, the splitter alone, and the split with LFO curves applied and the bands summed,
+       as the processor's sub-block loop does with every band audible */
+    template <typename SampleType>
+    std::array<double, 3> measure(int numChannels)
+    {
+        auto input = makeNoise<SampleType>(numChannels);
+        juce::AudioBuffer<SampleType> output(numChannels, numSamples);
+        juce::AudioBuffer<SampleType> curves(numBands, subBlockSize);
+
+        std::array<LFO, numBands> lfos;
+
+        for (auto& lfo : lfos)
+        {
+            lfo.setDsp(false);
+            lfo.setWaveDepth(50.f);
+            lfo.initializeLFO(sampleRate);
+            lfo.updateLFO(sampleRate, 120.0);
+        }
+
+        BandSplitter<SampleType> splitter;
+        splitter.setNumBands(numBands);
+        splitter.prepare({ sampleRate, (juce::uint32)subBlockSize, (juce::uint32)numChannels });
+
+        auto toNsPerFrame = [](double ms) { return ms * 1.0e6 / numSamples; };
+
+        auto lfoMs = Benchmarks::fastestRunMs(numRuns, [&]
+        {
+            for (int start = 0; start < numSamples; start += subBlockSize)
+                lfos[0].renderBlock(curves.getWritePointer(0), subBlockSize);
+        });
+
+        auto splitterMs = Benchmarks::fastestRunMs(numRuns, [&]
+        {
+            for (int start = 0; start < numSamples; start += subBlockSize)
+            {
+                juce::AudioBuffer<SampleType> subBlock(input.getArrayOfWritePointers(), numChannels, start, subBlockSize);
+                splitter.process(subBlock);
+            }
+        });
+
+        auto chainMs = Benchmarks::fastestRunMs(numRuns, [&]
+        {
+            for (int start = 0; start < numSamples; start += subBlockSize)
+            {
+                juce::AudioBuffer<SampleType> subBlock(input.getArrayOfWritePointers(), numChannels, start, subBlockSize);
+                splitter.process(subBlock);
+
+                for (int band = 0; band < numBands; ++band)
+                    lfos[(size_t)band].renderBlock(curves.getWritePointer(band), subBlockSize);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* out = output.getWritePointer(channel, start);
+                    auto* low = splitter.getBand(0).getReadPointer(channel);
+                    auto* mid = splitter.getBand(1).getReadPointer(channel);
+                    auto* high = splitter.getBand(2).getReadPointer(channel);
+                    auto* lowCurve = curves.getReadPointer(0);
+                    auto* midCurve = curves.getReadPointer(1);
+                    auto* highCurve = curves.getReadPointer(2);
+
+                    for (int i = 0; i < subBlockSize; ++i)
+                        out[i] = low[i] * lowCurve[i] + mid[i] * midCurve[i] + high[i] * highCurve[i];
+                }
+            }
+        });
+
+        return { toNsPerFrame(lfoMs), toNsPerFrame(splitterMs), toNsPerFrame(chainMs) };
+    }
+}
+
+/* The float and double instantiations side by side, in stereo and with 8 channels */
+//==============================================================================
+void Benchmarks::samplePrecision()
+{
+    std::cout << "ns per sample frame        float    double" << std::endl;
+
+    for (auto numChannels : { 2, 8 })
+    {
+        auto single = measure<float>(numChannels);
+        auto twice = measure<double>(numChannels);
+
+        const char* rowNames[] = { "LFO renderBlock", "BandSplitter", "sub-block chain" };
+
+        for (size_t row = 0; row < 3; ++row)
+        {
+            if (row == 0 && numChannels != 2)
+                continue;   // The LFO doesn't depend on the channel count
+
+            auto name = juce::String(rowNames[row]) + (row == 0 ? "" : ", " + juce::String(numChannels) + " ch");
+
+            std::cout << name.paddedRight(' ', 24)
+                      << juce::String(single[row], 1).paddedLeft(' ', 8)
+                      << juce::String(twice[row], 1).paddedLeft(' ', 10) << std::endl;
+        }
+    }
+}
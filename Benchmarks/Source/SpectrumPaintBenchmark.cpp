@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    SpectrumPaintBenchmark.cpp
+    Created: 17 Oct 2026 4:12:36pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/GUI/Display/SpectrumRenderer.h"
+
+/* Worst-case spectrum drawing, rasterised by JUCE's software renderer into an offscreen image:
+   every trace active and moving everywhere, so each frame is a full repaint. Sizes are the
+   spectrum area of the default editor, at the usual display scales */
+//==============================================================================
+void Benchmarks::spectrumPaint()
+{
+    constexpr int width = 696, height = 211;    // Spectrum area of the 750 x 515 editor
+    constexpr int numPoints = 512;              // TertiaryAudioProcessor::scopeSize
+
+    std::cout << "scale   size           ms per frame" << std::endl;
+
+    for (auto scale : { 1.0, 1.5, 2.0 })
+    {
+        auto scaledWidth = juce::roundToInt(width * scale);
+        auto scaledHeight = juce::roundToInt(height * scale);
+
+        // Mean of 50 frames, best of 5 passes
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (int pass = 0; pass < 5; ++pass)
+            fastest = juce::jmin(fastest, SpectrumRenderer::measurePaintTime(scaledWidth, scaledHeight, numPoints, 50));
+
+        std::cout << juce::String(scale, 1).paddedRight(' ', 8)
+                  << (juce::String(scaledWidth) + " x " + juce::String(scaledHeight)).paddedRight(' ', 15)
+                  << juce::String(fastest, 3) << std::endl;
+    }
+}
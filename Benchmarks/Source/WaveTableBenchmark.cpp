@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    WaveTableBenchmark.cpp
+    Created: 17 Oct 2026 6:24:50pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "../../Source/DSP/WaveTableBank.h"
+
+namespace
+{
+    constexpr int tableSize = WaveTableBank::tableSize;
+
+    /* WaveTableBank::fillShape() and normalise() as they were before the polynomial generator,
+       in double precision with std::sin and std::atan. Kept verbatim as the reference */
+    void fillOriginalShape(int shape, float* destination)
+    {
+        using namespace juce;
+
+        const auto pi = MathConstants<double>::pi;
+        const auto half = tableSize / 2;
+
+        /* Rounds the corners of the ramps and the square's edges */
+        const auto delta = 0.01;
+        const auto rounding = [delta](double x) { return std::atan(std::sin(x) / delta) / std::atan(1.0 / delta); };
+
+        for (int i = 0; i < tableSize; ++i)
+        {
+            auto isLeft = i < half;
+            auto position = (double)(isLeft ? i : i - half) / half;     // [0, 1) within the current half
+            auto cycle = (double)i / tableSize;                         // [0, 1) within the whole table
+            double y = 0.0;
+
+            switch (shape)
+            {
+                case WaveTableBank::rampDown:  y = (1.0 - cycle) * rounding(pi * cycle); break;
+                case WaveTableBank::rampUp:    y = cycle * rounding(pi * cycle); break;
+                case WaveTableBank::square:    y = 0.5 + (isLeft ? 0.5 : -0.5) * rounding(pi * position); break;
+                case WaveTableBank::triangle:  y = isLeft ? position : 1.0 - position; break;
+                case WaveTableBank::sine:      y = 0.5 + (isLeft ? 0.5 : -0.5) * std::sin(pi * position); break;
+                case WaveTableBank::hills:     y = isLeft ? std::sin(0.5 * pi * position) : std::cos(0.5 * pi * position); break;
+                case WaveTableBank::valleys:   y = isLeft ? 1.0 - std::sin(0.5 * pi * position) : 1.0 - std::cos(0.5 * pi * position); break;
+                default:                       break;
+            }
+
+            destination[i] = (float)y;
+        }
+
+        auto range = juce::FloatVectorOperations::findMinAndMax(destination, tableSize);
+
+        if (range.getLength() <= 0.f)
+            return;
+
+        juce::FloatVectorOperations::add(destination, -range.getStart(), tableSize);
+        juce::FloatVectorOperations::multiply(destination, 1.f / range.getLength(), tableSize);
+    }
+}
+
+/* Checks every sample of the bank against the original std:: tables, and times building each */
+//==============================================================================
+void Benchmarks::waveTables()
+{
+    const char* shapeNames[] = { "ramp down", "ramp up", "square", "triangle", "sine", "hills", "valleys" };
+    static_assert(std::size(shapeNames) == WaveTableBank::numShapes, "One name per shape");
+
+    WaveTableBank bank;
+    std::vector<float> reference((size_t)tableSize);
+    auto worstError = 0.f;
+
+    std::cout << "shape        max error against std:: tables" << std::endl;
+
+    for (int shape = 0; shape < WaveTableBank::numShapes; ++shape)
+    {
+        fillOriginalShape(shape, reference.data());
+
+        auto* table = bank.getTable(shape);
+        auto maxError = 0.f;
+
+        for (int i = 0; i < tableSize; ++i)
+            maxError = juce::jmax(maxError, std::abs(table[i] - reference[(size_t)i]));
+
+        worstError = juce::jmax(worstError, maxError);
+
+        std::cout << juce::String(shapeNames[shape]).paddedRight(' ', 13) << juce::String(maxError, 2, true) << std::endl;
+    }
+
+    std::cout << (worstError <= WaveTableBank::maxGeneratorError ? "within " : "EXCEEDS ")
+              << "maxGeneratorError (" << juce::String(WaveTableBank::maxGeneratorError, 1, true) << ")" << std::endl;
+
+    jassert(worstError <= WaveTableBank::maxGeneratorError);
+
+    auto bankMs = fastestRunMs(50, [] { WaveTableBank newBank; });
+
+    auto referenceMs = fastestRunMs(50, [&]
+    {
+        for (int shape = 0; shape < WaveTableBank::numShapes; ++shape)
+            fillOriginalShape(shape, reference.data());
+    });
+
+    std::cout << "building all tables: " << juce::String(bankMs * 1000.0, 1) << " us, std:: reference "
+              << juce::String(referenceMs * 1000.0, 1) << " us" << std::endl;
+}
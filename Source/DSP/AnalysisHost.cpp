@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    AnalysisHost.cpp
+    Created: 17 Oct 2026 8:54:06pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "AnalysisHost.h"
+
+/* Meters publish silence until they're first prepared, rather than the zeros they start with */
+//==============================================================================
+AnalysisState::AnalysisState(int numDisplayPoints)
+    : spectrumAnalyzer({ &mixFeed, &lowBandFeed, &midBandFeed, &highBandFeed }, numDisplayPoints)
+{
+    inputMeter.reset();
+    outputMeter.reset();
+}
+
+//==============================================================================
+void AnalysisState::prepare(double sampleRate, int numChannels, int maximumBlockSize)
+{
+    inputMeter.prepare(sampleRate, numChannels, maximumBlockSize);
+    outputMeter.prepare(sampleRate, numChannels, maximumBlockSize);
+
+    for (auto* feed : { &mixFeed, &lowBandFeed, &midBandFeed, &highBandFeed })
+        feed->prepare(maximumBlockSize);
+
+    spectrumAnalyzer.prepare(sampleRate);
+}
+
+//==============================================================================
+AnalysisHost::AnalysisHost(int numDisplayPoints)
+    : numPoints(numDisplayPoints)
+{
+}
+
+/* Consumers must be gone by now, and so must the audio thread */
+//==============================================================================
+AnalysisHost::~AnalysisHost()
+{
+    jassert(numConsumers == 0);
+
+    stopTimer();
+    published = nullptr;
+}
+
+/* A live state is prepared along with everything else; one created later picks up the same spec */
+//==============================================================================
+void AnalysisHost::prepare(double sampleRate, int numChannels, int maximumBlockSize)
+{
+    const juce::ScopedLock sl(lock);
+
+    preparedSampleRate = sampleRate;
+    preparedNumChannels = numChannels;
+    preparedBlockSize = maximumBlockSize;
+
+    if (state != nullptr)
+        state->prepare(sampleRate, numChannels, maximumBlockSize);
+}
+
+/* Creates the state on first use, or takes it back from the grace period, and publishes it */
+//==============================================================================
+void AnalysisHost::attach()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (numConsumers++ > 0)
+        return;
+
+    stopTimer();
+
+    const juce::ScopedLock sl(lock);
+
+    if (state == nullptr)
+    {
+        state = std::make_unique<AnalysisState>(numPoints);
+
+        if (preparedSampleRate > 0)
+            state->prepare(preparedSampleRate, preparedNumChannels, preparedBlockSize);
+
+        if (onCreate != nullptr)
+            onCreate(*state);
+    }
+
+    published = state.get();
+}
+
+//==============================================================================
+void AnalysisHost::detach()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+    jassert(numConsumers > 0);
+
+    if (--numConsumers == 0)
+        startTimer(gracePeriodMs);
+}
+
+//==============================================================================
+void AnalysisHost::timerCallback()
+{
+    if (numConsumers > 0 || state == nullptr)
+    {
+        stopTimer();
+        return;
+    }
+
+    /* Grace period over: stop the audio thread picking it up, then wait out any block still using it */
+    if (published.load() != nullptr)
+    {
+        published = nullptr;
+        startTimer(releasePollMs);
+        return;
+    }
+
+    if (audioInUse.load())
+        return;
+
+    stopTimer();
+
+    const juce::ScopedLock sl(lock);
+    state.reset();
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    AnalysisHost.h
+    Created: 17 Oct 2026 8:54:06pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "AnalyzerFeed.h"
+#include "SpectrumAnalyzer.h"
+#include "LevelMeter.h"
+
+/* Everything the processor measures for display: the input and output meters, and the spectrum
+   analyzer with its feeds. Only exists while something is looking at it */
+struct AnalysisState
+{
+    explicit AnalysisState(int numDisplayPoints);
+
+    /* Before audio */
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+
+    AnalyzerFeed& getBandFeed(int band) { return *std::array<AnalyzerFeed*, 3>{ &lowBandFeed, &midBandFeed, &highBandFeed }[(size_t)band]; }
+
+    LevelMeter inputMeter, outputMeter;
+
+    AnalyzerFeed mixFeed;                               // Full signal at the pickoff point
+    AnalyzerFeed lowBandFeed, midBandFeed, highBandFeed;
+    SpectrumAnalyzer spectrumAnalyzer;                  // One trace per feed, in the order above
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisState)
+};
+
+/* Owns the AnalysisState, and decides when it exists. The first Consumer to attach creates it;
+   once the last one detaches it is kept for gracePeriodMs, so closing and reopening the editor
+   doesn't throw the analysis away, then released.
+   The audio thread finds it through an atomic pointer, and flags each block it spends using it.
+   Releasing unpublishes the pointer first and only deletes once no block is still holding it,
+   so the audio thread never waits, never allocates and never sees a half-built state */
+class AnalysisHost : private juce::Timer
+{
+public:
+    static constexpr int gracePeriodMs = 5000;
+
+    explicit AnalysisHost(int numDisplayPoints);
+    ~AnalysisHost() override;
+
+    /* Before audio. Remembered for states created later */
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+
+    /* Message thread. Called on each newly created state, before the audio thread can see it */
+    std::function<void(AnalysisState&)> onCreate;
+
+    /* Message thread. Non-null while any Consumer is attached */
+    AnalysisState* getState() const noexcept { return state.get(); }
+
+    /* Message thread. Keeps the state alive for as long as it exists: the editor, or a headless consumer */
+    class Consumer
+    {
+    public:
+        explicit Consumer(AnalysisHost& hostToUse) : host(hostToUse) { host.attach(); }
+        ~Consumer() { host.detach(); }
+
+        AnalysisState& getState() const noexcept { return *host.getState(); }
+
+    private:
+        AnalysisHost& host;
+
+        JUCE_DECLARE_NON_COPYABLE(Consumer)
+    };
+
+    /* Audio thread. Points target at the published state, or nullptr if there is none, for one block */
+    class ScopedAudioAccess
+    {
+    public:
+        ScopedAudioAccess(AnalysisHost& hostToUse, AnalysisState*& target) noexcept
+            : host(hostToUse), accessTarget(target)
+        {
+            host.audioInUse.store(true);
+            accessTarget = host.published.load();
+        }
+
+        ~ScopedAudioAccess()
+        {
+            accessTarget = nullptr;
+            host.audioInUse.store(false);
+        }
+
+    private:
+        AnalysisHost& host;
+        AnalysisState*& accessTarget;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioAccess)
+    };
+
+private:
+    void attach();
+    void detach();
+
+    /* Counts down the grace period, then releases in two steps: unpublish, then delete */
+    void timerCallback() override;
+
+    const int numPoints;
+
+    std::unique_ptr<AnalysisState> state;
+    int numConsumers{ 0 };                              // Message thread
+
+    /* Both sequentially consistent: once the message thread has unpublished and then seen
+       audioInUse clear, no block can still be holding the old pointer */
+    std::atomic<AnalysisState*> published{ nullptr };
+    std::atomic<bool> audioInUse{ false };
+
+    static constexpr int releasePollMs = 50;
+
+    /* Creating, preparing and releasing may come from different non-audio threads */
+    juce::CriticalSection lock;
+    double preparedSampleRate{ 0 };
+    int preparedNumChannels{ 0 }, preparedBlockSize{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalysisHost)
+};
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    AnalyzerFeed.cpp
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "AnalyzerFeed.h"
+
+//==============================================================================
+AnalyzerFeed::AnalyzerFeed()
+{
+    queue.setTotalSize(capacity);
+}
+
+//==============================================================================
+void AnalyzerFeed::prepare(int maximumBlockSize)
+{
+    mixdown.assign((size_t)juce::jmax(1, maximumBlockSize), 0.f);
+}
+
+/* Average of all channels, so wide layouts read at the same level as stereo.
+   If the ring is full the block is dropped: the analyzer is behind, and will skip ahead anyway */
+//==============================================================================
+template <typename SampleType>
+void AnalyzerFeed::push(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, const SampleType* gain) noexcept
+{
+    auto numChannels = buffer.getNumChannels();
+
+    if (numChannels == 0 || mixdown.empty())
+        return;
+
+    auto channelScale = 1.f / (float)numChannels;
+    auto* mono = mixdown.data();
+
+    for (int offset = 0; offset < numSamples; offset += (int)mixdown.size())
+    {
+        auto start = startSample + offset;
+        auto chunkSize = juce::jmin((int)mixdown.size(), numSamples - offset);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            juce::FloatVectorOperations::copyWithMultiply(mono, buffer.getReadPointer(0, start), channelScale, chunkSize);
+
+            for (int channel = 1; channel < numChannels; channel++)
+                juce::FloatVectorOperations::addWithMultiply(mono, buffer.getReadPointer(channel, start), channelScale, chunkSize);
+
+            if (gain != nullptr)
+                juce::FloatVectorOperations::multiply(mono, gain + offset, chunkSize);
+        }
+        else
+        {
+            std::fill(mono, mono + chunkSize, 0.f);
+
+            for (int channel = 0; channel < numChannels; channel++)
+            {
+                auto* input = buffer.getReadPointer(channel, start);
+
+                for (int i = 0; i < chunkSize; i++)
+                    mono[i] += (float)input[i] * channelScale;
+            }
+
+            if (gain != nullptr)
+                for (int i = 0; i < chunkSize; i++)
+                    mono[i] *= (float)gain[offset + i];
+        }
+
+        queue.writeTo(mono, chunkSize);
+    }
+}
+
+template void AnalyzerFeed::push<float>(const juce::AudioBuffer<float>&, int, int, const float*) noexcept;
+template void AnalyzerFeed::push<double>(const juce::AudioBuffer<double>&, int, int, const double*) noexcept;
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    AnalyzerFeed.h
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "LockFreeQueue.h"
+
+/* Carries the analyzer signal from the audio thread to the spectrum analyzer.
+   The audio thread mixes each block down to mono and makes one bulk write into a lock-free ring;
+   the analyzer drains it into frames of its own. Neither side ever waits for the other, and the
+   audio thread never touches memory the analyzer is transforming. The ring only has to bridge the
+   analyzer's polling interval, so its size doesn't depend on the FFT size */
+class AnalyzerFeed
+{
+public:
+    static constexpr int capacity = 1 << 14;     // Samples. Over 80 ms at 192 kHz
+
+    AnalyzerFeed();
+
+    /* Before audio. Sizes the audio thread's mixdown buffer */
+    void prepare(int maximumBlockSize);
+
+    /* Audio thread. Pushes the whole buffer */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer) noexcept { push<SampleType>(buffer, 0, buffer.getNumSamples(), nullptr); }
+
+    /* Audio thread. Pushes a range of buffer, optionally scaled sample by sample by a gain curve of numSamples.
+       Instantiated for float and double */
+    template <typename SampleType>
+    void push(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples, const SampleType* gain) noexcept;
+
+    /* Analyzer thread */
+    int getNumReady() const noexcept { return queue.getNumReady(); }
+    void read(float* dest, int numSamples) noexcept { queue.readFrom(dest, numSamples); }
+    void discard(int numSamples) noexcept { queue.discard(numSamples); }
+    void flush() noexcept { queue.discard(queue.getNumReady()); }
+
+private:
+    LockFreeQueue<float> queue;
+    std::vector<float> mixdown;     // Audio thread only
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AnalyzerFeed)
+};
@@ -0,0 +1,418 @@
+/*
+  ==============================================================================
+
+    BandSplitter.cpp
+    Created: 17 Oct 2026 9:12:04am
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "BandSplitter.h"
+
+/* Rebuilds the tree of filter stages for the requested number of bands */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::setNumBands(int newNumBands)
+{
+    numBands = juce::jlimit(minBands, maxBands, newNumBands);
+
+    /* Every crossover starts over, spread evenly (in log-frequency) across the audible range */
+    for (int i = 0; i < getNumCrossovers(); ++i)
+    {
+        crossoverFrequencies[(size_t)i] = (SampleType)(20.0 * std::pow(1000.0, (i + 1) / (double)numBands));
+        frequencyGlides[(size_t)i].setCurrentAndTargetValue(crossoverFrequencies[(size_t)i]);
+    }
+
+    stages.clear();
+    stages.reserve((size_t)(numBands * numBands));
+
+    buildStages(0, numBands, inputSource);
+
+    allpassFilters.assign((size_t)getNumCrossovers(), {});
+
+    for (int i = 0; i < getNumCrossovers(); ++i)
+    {
+        allpassFilters[(size_t)i].type = FilterType::allpass;
+        allpassFilters[(size_t)i].setCutoffFrequency(crossoverFrequencies[(size_t)i]);
+    }
+
+    if (preparedSpec.maximumBlockSize > 0)
+        prepare(preparedSpec);
+}
+
+/* Splits bands [lowBand, highBand) out of source at the middle crossover, then recurses.
+   The high branch is filtered first, since the low branch may overwrite source in-place */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::buildStages(int lowBand, int highBand, int source)
+{
+    if (highBand - lowBand < 2)
+        return;
+
+    auto split = lowBand + (highBand - lowBand) / 2 - 1;  // Crossover between the two halves
+    auto firstHighBand = split + 1;
+
+    /* High branch: highpass, then compensate for every crossover left in the low branch */
+    addStage(FilterType::highpass, split, source, firstHighBand);
+
+    for (int crossover = lowBand; crossover < split; ++crossover)
+        addStage(FilterType::allpass, crossover, firstHighBand, firstHighBand);
+
+    /* Low branch: lowpass, then compensate for every crossover left in the high branch */
+    addStage(FilterType::lowpass, split, source, lowBand);
+
+    for (int crossover = firstHighBand; crossover < highBand - 1; ++crossover)
+        addStage(FilterType::allpass, crossover, lowBand, lowBand);
+
+    buildStages(firstHighBand, highBand, firstHighBand);
+    buildStages(lowBand, firstHighBand, lowBand);
+}
+
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::addStage(FilterType type, int crossover, int source, int destination)
+{
+    Stage stage;
+    stage.filter.type = type;
+    stage.filter.setCutoffFrequency(crossoverFrequencies[(size_t)crossover]);
+    stage.crossover = crossover;
+    stage.source = source;
+    stage.destination = destination;
+
+    stages.push_back(std::move(stage));
+}
+
+/* Housekeeping PRIOR TO audio processing */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    preparedSpec = spec;
+
+    auto numGroups = ((int)spec.numChannels + numLanes - 1) / numLanes;
+
+    for (auto& stage : stages)
+        stage.filter.prepare(spec.sampleRate, numGroups);
+
+    for (auto& filter : allpassFilters)
+        filter.prepare(spec.sampleRate, numGroups);
+
+    // Land on any pending targets, so playback starts at the right frequencies
+    for (int i = 0; i < getNumCrossovers(); ++i)
+    {
+        frequencyGlides[(size_t)i].reset(spec.sampleRate, glideSeconds);
+        applyCrossoverFrequency(i, frequencyGlides[(size_t)i].getTargetValue());
+    }
+
+    for (auto& band : bands)
+        band.setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+
+    inputLanes.resize((size_t)spec.maximumBlockSize);
+
+    for (auto& lanes : bandLanes)
+        lanes.resize((size_t)spec.maximumBlockSize);
+}
+
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::reset()
+{
+    for (auto& stage : stages)
+        stage.filter.reset();
+
+    for (auto& filter : allpassFilters)
+        filter.reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::setCrossoverFrequency(int crossoverIndex, SampleType frequency)
+{
+    jassert(juce::isPositiveAndBelow(crossoverIndex, getNumCrossovers()));
+
+    auto& glide = frequencyGlides[(size_t)crossoverIndex];
+
+    if (frequency != glide.getTargetValue())
+        glide.setTargetValue(frequency);
+}
+
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::snapToTargets()
+{
+    for (int i = 0; i < getNumCrossovers(); ++i)
+    {
+        auto& glide = frequencyGlides[(size_t)i];
+        glide.setCurrentAndTargetValue(glide.getTargetValue());
+        applyCrossoverFrequency(i, glide.getTargetValue());
+    }
+}
+
+/* Recomputes coefficients, but only for the filters driven by this crossover, and only if it moved */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::applyCrossoverFrequency(int crossoverIndex, SampleType frequency)
+{
+    if (frequency == crossoverFrequencies[(size_t)crossoverIndex])
+        return;
+
+    crossoverFrequencies[(size_t)crossoverIndex] = frequency;
+
+    for (auto& stage : stages)
+        if (stage.crossover == crossoverIndex)
+            stage.filter.setCutoffFrequency(frequency);
+
+    allpassFilters[(size_t)crossoverIndex].setCutoffFrequency(frequency);
+}
+
+/* The allpass decays as exp(-t / tau), with tau = 1 / (sqrt(0.5) * 2 pi fc).
+   Twelve time constants leaves less than -80 dB, even for the LR4 lowpass and highpass with their double poles */
+//==============================================================================
+template <typename SampleType>
+int BandSplitter<SampleType>::getSettlingSamples() const
+{
+    auto lowest = (double)frequencyGlides[0].getTargetValue();
+
+    for (int i = 0; i < getNumCrossovers(); ++i)
+        lowest = juce::jmin(lowest, (double)crossoverFrequencies[(size_t)i], (double)frequencyGlides[(size_t)i].getTargetValue());
+
+    auto timeConstant = 1.0 / (std::sqrt(0.5) * juce::MathConstants<double>::twoPi * lowest);
+
+    return (int)std::ceil(12.0 * timeConstant * preparedSpec.sampleRate);
+}
+
+/* Runs every stage of the tree, one channel group at a time. Each filter reads straight from its source,
+   so no band is filled by copying */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::process(const juce::AudioBuffer<SampleType>& input, juce::AudioBuffer<SampleType>* allpassed)
+{
+    auto numChannels = input.getNumChannels();
+    auto numSamples = input.getNumSamples();
+
+    jassert(numChannels <= (int)preparedSpec.numChannels);
+    jassert(allpassed == nullptr || (allpassed->getNumChannels() == numChannels && allpassed->getNumSamples() == numSamples));
+
+    // Match band buffers to this block. Shrinking within the prepared capacity never reallocates.
+    for (int band = 0; band < numBands; ++band)
+        bands[(size_t)band].setSize(numChannels, numSamples, false, false, true);
+
+    run(&input, allpassed);
+}
+
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::processAllpass(juce::AudioBuffer<SampleType>& buffer)
+{
+    jassert(buffer.getNumChannels() <= (int)preparedSpec.numChannels);
+
+    run(nullptr, &buffer);
+}
+
+/* Runs the tree on input and the allpass path on allpassed, whichever are given. The glides advance once for both,
+   so the two paths always share coefficients. While a crossover is gliding, the block is split into
+   glideStepSamples-long steps with fresh coefficients */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::run(const juce::AudioBuffer<SampleType>* input, juce::AudioBuffer<SampleType>* allpassed)
+{
+    auto& reference = input != nullptr ? *input : *allpassed;
+    auto numSamples = reference.getNumSamples();
+    auto numGroups = (reference.getNumChannels() + numLanes - 1) / numLanes;
+
+    auto isGliding = false;
+
+    for (int i = 0; i < getNumCrossovers(); ++i)
+        isGliding = isGliding || frequencyGlides[(size_t)i].isSmoothing();
+
+    auto stepSize = isGliding ? glideStepSamples : (int)inputLanes.size();
+
+    for (int start = 0; start < numSamples; start += stepSize)
+    {
+        auto numStepSamples = juce::jmin(stepSize, numSamples - start);
+
+        if (isGliding)
+            for (int i = 0; i < getNumCrossovers(); ++i)
+                applyCrossoverFrequency(i, frequencyGlides[(size_t)i].skip(numStepSamples));
+
+        for (int group = 0; group < numGroups; ++group)
+        {
+            if (input != nullptr)
+                processGroup(*input, group, start, numStepSamples);
+
+            if (allpassed != nullptr)
+                processAllpassGroup(*allpassed, group, start, numStepSamples);
+        }
+    }
+}
+
+/* Lanes past the last channel carry silence */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::interleave(const juce::AudioBuffer<SampleType>& source, int group, int startSample, int numSamples)
+{
+    auto firstChannel = group * numLanes;
+    auto numGroupChannels = juce::jmin(numLanes, source.getNumChannels() - firstChannel);
+    auto* interleaved = reinterpret_cast<SampleType*>(inputLanes.data());
+
+    if (numGroupChannels < numLanes)
+        std::fill(interleaved, interleaved + numSamples * numLanes, SampleType());
+
+    for (int lane = 0; lane < numGroupChannels; ++lane)
+    {
+        auto* in = source.getReadPointer(firstChannel + lane, startSample);
+
+        for (int i = 0; i < numSamples; ++i)
+            interleaved[i * numLanes + lane] = in[i];
+    }
+}
+
+/* Interleaves up to numLanes channels into registers, runs the tree on them, and de-interleaves each band */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::processGroup(const juce::AudioBuffer<SampleType>& input, int group, int startSample, int numSamples)
+{
+    auto firstChannel = group * numLanes;
+    auto numGroupChannels = juce::jmin(numLanes, input.getNumChannels() - firstChannel);
+
+    interleave(input, group, startSample, numSamples);
+
+    /* Filter */
+    for (auto& stage : stages)
+    {
+        auto* source = stage.source == inputSource ? inputLanes.data() : bandLanes[(size_t)stage.source].data();
+        stage.filter.process(source, bandLanes[(size_t)stage.destination].data(), numSamples, group);
+    }
+
+    /* De-interleave */
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto* bandInterleaved = reinterpret_cast<const SampleType*>(bandLanes[(size_t)band].data());
+
+        for (int lane = 0; lane < numGroupChannels; ++lane)
+        {
+            auto* out = bands[(size_t)band].getWritePointer(firstChannel + lane, startSample);
+
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = bandInterleaved[i * numLanes + lane];
+        }
+    }
+}
+
+/* Reuses the input lanes, which the tree has finished with by now */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::processAllpassGroup(juce::AudioBuffer<SampleType>& buffer, int group, int startSample, int numSamples)
+{
+    auto firstChannel = group * numLanes;
+    auto numGroupChannels = juce::jmin(numLanes, buffer.getNumChannels() - firstChannel);
+
+    interleave(buffer, group, startSample, numSamples);
+
+    for (auto& filter : allpassFilters)
+        filter.process(inputLanes.data(), inputLanes.data(), numSamples, group);
+
+    auto* interleaved = reinterpret_cast<const SampleType*>(inputLanes.data());
+
+    for (int lane = 0; lane < numGroupChannels; ++lane)
+    {
+        auto* out = buffer.getWritePointer(firstChannel + lane, startSample);
+
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = interleaved[i * numLanes + lane];
+    }
+}
+
+/* LaneFilter */
+//==============================================================================
+template <typename SampleType>
+void BandSplitter<SampleType>::LaneFilter::prepare(double newSampleRate, int numGroups)
+{
+    sampleRate = newSampleRate;
+
+    for (auto* state : { &s1, &s2, &s3, &s4 })
+        state->resize((size_t)numGroups);
+
+    update();
+    reset();
+}
+
+template <typename SampleType>
+void BandSplitter<SampleType>::LaneFilter::reset()
+{
+    for (auto* state : { &s1, &s2, &s3, &s4 })
+        std::fill(state->begin(), state->end(), splat(0));
+}
+
+template <typename SampleType>
+void BandSplitter<SampleType>::LaneFilter::setCutoffFrequency(SampleType newCutoff)
+{
+    cutoff = newCutoff;
+    update();
+}
+
+template <typename SampleType>
+void BandSplitter<SampleType>::LaneFilter::update()
+{
+    g  = (SampleType)std::tan(juce::MathConstants<double>::pi * cutoff / sampleRate);
+    R2 = (SampleType)std::sqrt(2.0);
+    h  = (SampleType)(1.0 / (1.0 + R2 * g + g * g));
+}
+
+/* The filter type is resolved once per call, outside the sample loop */
+template <typename SampleType>
+void BandSplitter<SampleType>::LaneFilter::process(const Vector* source, Vector* destination, int numSamples, int group) noexcept
+{
+    switch (type)
+    {
+        case FilterType::lowpass:   processLanes<FilterType::lowpass>(source, destination, numSamples, group);  break;
+        case FilterType::highpass:  processLanes<FilterType::highpass>(source, destination, numSamples, group); break;
+        case FilterType::allpass:   processLanes<FilterType::allpass>(source, destination, numSamples, group);  break;
+    }
+}
+
+/* source and destination may be the same buffer; each sample is read before it is written */
+template <typename SampleType>
+template <juce::dsp::LinkwitzRileyFilterType filterType>
+void BandSplitter<SampleType>::LaneFilter::processLanes(const Vector* source, Vector* destination, int numSamples, int group) noexcept
+{
+    auto state1 = s1[(size_t)group], state2 = s2[(size_t)group];
+    auto state3 = s3[(size_t)group], state4 = s4[(size_t)group];
+    auto R2PlusG = R2 + g;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto yH = (source[i] - state1 * R2PlusG - state2) * h;
+
+        auto yB = yH * g + state1;
+        state1 = yH * g + yB;
+
+        auto yL = yB * g + state2;
+        state2 = yB * g + yL;
+
+        if constexpr (filterType == FilterType::allpass)
+        {
+            destination[i] = yL - yB * R2 + yH;
+        }
+        else
+        {
+            auto yH2 = ((filterType == FilterType::lowpass ? yL : yH) - state3 * R2PlusG - state4) * h;
+
+            auto yB2 = yH2 * g + state3;
+            state3 = yH2 * g + yB2;
+
+            auto yL2 = yB2 * g + state4;
+            state4 = yB2 * g + yL2;
+
+            destination[i] = filterType == FilterType::lowpass ? yL2 : yH2;
+        }
+    }
+
+    s1[(size_t)group] = state1;  s2[(size_t)group] = state2;
+    s3[(size_t)group] = state3;  s4[(size_t)group] = state4;
+}
+
+//==============================================================================
+template class BandSplitter<float>;
+template class BandSplitter<double>;
@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    BandSplitter.h
+    Created: 17 Oct 2026 9:12:04am
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Splits a signal into 2 to 8 bands using a balanced tree of Linkwitz-Riley crossovers.
+   Each branch of the tree is allpass-compensated for the crossovers in the opposite
+   branch, so the bands always re-sum to an allpass copy of the input. That allpass is also
+   kept on its own, so a dry signal can be phase-matched to the bands.
+   Channels are filtered side by side in SIMD lanes, so wide layouts cost far less
+   than running the tree once per channel */
+template <typename SampleType>
+class BandSplitter
+{
+public:
+    static constexpr int minBands = 2;
+    static constexpr int maxBands = 8;
+
+    /* Rebuilds the crossover tree, and resets every crossover to an even log-frequency spread, so set them
+       again afterwards. Allocates, so call before prepare() or while audio is stopped */
+    void setNumBands(int newNumBands);
+    int getNumBands() const { return numBands; }
+    int getNumCrossovers() const { return numBands - 1; }
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /* Crossover i sits between band i and band i + 1. Changes glide over glideSeconds,
+       and an unchanged frequency costs nothing */
+    void setCrossoverFrequency(int crossoverIndex, SampleType frequency);
+    SampleType getCrossoverFrequency(int crossoverIndex) const { return crossoverFrequencies[(size_t)crossoverIndex]; }
+
+    /* Lands every crossover on its target at once. The glides only advance inside process(), so call this
+       after a stretch without it, rather than sweeping on from wherever they stopped */
+    void snapToTargets();
+
+    static constexpr double glideSeconds = 0.05;
+    static constexpr int glideStepSamples = 32;     // Coefficients are recomputed at most this often while gliding
+
+    /* Splits input into the band buffers. If allpassed is given, it is also run in place through the
+       allpass path, so it can be mixed with the bands without comb filtering. allpassed may be input itself,
+       to take the bands off a signal on its way through the allpass. Never allocates once prepared */
+    void process(const juce::AudioBuffer<SampleType>& input, juce::AudioBuffer<SampleType>* allpassed = nullptr);
+
+    /* Runs buffer in place through the allpass path alone: one Linkwitz-Riley allpass per crossover,
+       which is what the bands sum to. For when the bands themselves aren't needed */
+    void processAllpass(juce::AudioBuffer<SampleType>& buffer);
+
+    /* Samples either path needs, after being left idle, before its output matches the other's to
+       within -80 dB. Set by the lowest crossover, whose allpass rings the longest */
+    int getSettlingSamples() const;
+
+    juce::AudioBuffer<SampleType>& getBand(int bandIndex) { return bands[(size_t)bandIndex]; }
+
+    /* Number of filters run per sample and channel group, for the current band count */
+    int getNumFilterStages() const { return (int)stages.size(); }
+
+private:
+   #if JUCE_USE_SIMD
+    using Vector = juce::dsp::SIMDRegister<SampleType>;
+   #else
+    using Vector = SampleType;
+   #endif
+
+    /* Channels filtered together in one register */
+    static constexpr int numLanes = (int)(sizeof(Vector) / sizeof(SampleType));
+
+    static Vector splat(SampleType value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return Vector::expand(value);
+       #else
+        return value;
+       #endif
+    }
+
+    using FilterType = juce::dsp::LinkwitzRileyFilterType;
+
+    /* Same TPT topology as juce::dsp::LinkwitzRileyFilter, with one channel in each lane */
+    struct LaneFilter
+    {
+        void prepare(double newSampleRate, int numGroups);
+        void reset();
+        void setCutoffFrequency(SampleType newCutoff);
+        void process(const Vector* source, Vector* destination, int numSamples, int group) noexcept;
+
+        FilterType type{ FilterType::lowpass };
+
+    private:
+        template <FilterType filterType>
+        void processLanes(const Vector* source, Vector* destination, int numSamples, int group) noexcept;
+
+        void update();
+
+        double sampleRate{ 44100.0 };
+        SampleType cutoff{ 2000 };
+        SampleType g{}, R2{}, h{};
+        std::vector<Vector> s1, s2, s3, s4;     // One register per channel group
+    };
+
+    /* One filter in the tree, and where it reads from and writes to */
+    struct Stage
+    {
+        LaneFilter filter;
+        int crossover{ 0 };         // Which crossover frequency drives this filter
+        int source{ inputSource };  // Band buffer to read, or inputSource
+        int destination{ 0 };       // Band buffer to write
+    };
+
+    static constexpr int inputSource = -1;
+
+    void buildStages(int lowBand, int highBand, int source);
+    void addStage(FilterType type, int crossover, int source, int destination);
+    void applyCrossoverFrequency(int crossoverIndex, SampleType frequency);
+    void run(const juce::AudioBuffer<SampleType>* input, juce::AudioBuffer<SampleType>* allpassed);
+    void processGroup(const juce::AudioBuffer<SampleType>& input, int group, int startSample, int numSamples);
+    void processAllpassGroup(juce::AudioBuffer<SampleType>& buffer, int group, int startSample, int numSamples);
+    void interleave(const juce::AudioBuffer<SampleType>& source, int group, int startSample, int numSamples);
+
+    int numBands{ 3 };
+
+    std::vector<Stage> stages;      // Executed in order by process()
+    std::vector<LaneFilter> allpassFilters;     // The allpass path, one per crossover, in cascade
+    std::array<SampleType, maxBands - 1> crossoverFrequencies;     // Currently applied to the filters
+    std::array<juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative>, maxBands - 1> frequencyGlides;
+    std::array<juce::AudioBuffer<SampleType>, maxBands> bands;
+
+    /* Interleaved working buffers, holding one channel group at a time */
+    std::vector<Vector> inputLanes;
+    std::array<std::vector<Vector>, maxBands> bandLanes;
+
+    juce::dsp::ProcessSpec preparedSpec{ 44100.0, 0, 0 };
+};
@@ -10,49 +10,154 @@
 
 #include "LFO.h"
 
-/* Called once upon construction of AudioProcessor */
+/* Called before playback (and whenever the sample rate changes) */
 //==============================================================================
 void LFO::initializeLFO(double sampleRate)
 {
-
     mSampleRate = sampleRate;
+    waveTable = waveTableBank->getTable(mWaveShapeChoice);
+
+    for (auto* glide : { &depthGlide, &symmetryGlide, &invertGlide })
+        glide->reset(sampleRate, shapeGlideSeconds);
 
-    waveTable.resize(sampleRate / wtScalar);
-    waveTable.clearQuick();
+    mPhase = 0;
 
-    waveTableMapped.resize(sampleRate / wtScalar);
-    waveTableMapped.clearQuick();
-    
     waveTableForDisplay.clearQuick();   // Chopping Block
 }
 
-/* Called when LFO parameters are changed or updated */
+/* Called when LFO parameters are changed or updated. Lands on the new shape without gliding,
+   so only use where the caller owns the LFO (GUI, prepareToPlay) */
 //==============================================================================
 void LFO::updateLFO(double sampleRate, double hostBPM)
 {
-    
     if (isLinkedToDsp)
         getProcessorParams();
 
-    calculateWaveShape(sampleRate);
+    applyShape(true);
+
     setTempo(hostBPM, sampleRate);
 }
 
+/* Called on the audio thread when a shape parameter has changed. Costs the same whichever one it was */
+//==============================================================================
+void LFO::updateShape()
+{
+    if (isLinkedToDsp)
+        getShapeParams();
+
+    applyShape(false);
+}
+
+/* Selects the bank table and retargets depth, symmetry and invert */
+//==============================================================================
+void LFO::applyShape(bool skipGlides)
+{
+    waveTable = waveTableBank->getTable(mWaveShapeChoice);
+
+    depthGlide.setTargetValue(mDepth / 100.f);
+    symmetryGlide.setTargetValue(mSymmetry / 100.f);
+    invertGlide.setTargetValue(mInvert != 0 ? 1.f : 0.f);
+
+    if (skipGlides)
+        for (auto* glide : { &depthGlide, &symmetryGlide, &invertGlide })
+            glide->setCurrentAndTargetValue(glide->getTargetValue());
+}
+
+/* Called on the audio thread when a timing parameter has changed */
+//==============================================================================
+void LFO::updateTempo(double hostBPM)
+{
+    if (isLinkedToDsp)
+        getTimingParams();
+
+    setTempo(hostBPM, mSampleRate);
+}
+
+
+/* Moves the read-back position to a fraction of one cycle */
+//==============================================================================
+void LFO::setPhase(double newPhase)
+{
+    newPhase -= std::floor(newPhase);
+    mPhase = (juce::uint32)(newPhase * cyclesToPhase);
+}
+
+
+/* Renders one block of LFO amplitudes. The interpolation choice is
+   resolved once per block rather than once per sample */
+//==============================================================================
+template <typename SampleType>
+void LFO::renderBlock(SampleType* destination, int numSamples) noexcept
+{
+    auto phase = mPhase;
+
+    /* While a shape parameter is gliding, reshape every sample */
+    if (depthGlide.isSmoothing() || symmetryGlide.isSmoothing() || invertGlide.isSmoothing())
+    {
+        for (int i = 0; i < numSamples; ++i, phase += mPhaseIncrement)
+            destination[i] = (SampleType)readShaped(phase + mPhaseOffset,
+                                                    Warp(symmetryGlide.getNextValue()),
+                                                    invertGlide.getNextValue(),
+                                                    depthGlide.getNextValue());
+
+        mPhase = phase;
+        return;
+    }
+
+    const Warp warp(symmetryGlide.getCurrentValue());
+    const auto invert = invertGlide.getCurrentValue();
+    const auto depth = depthGlide.getCurrentValue();
+
+    if (mInterpolation == Interpolation::linear)
+    {
+        for (int i = 0; i < numSamples; ++i, phase += mPhaseIncrement)
+        {
+            auto value = readLinear(waveTable, warp(phase + mPhaseOffset));
+            value += invert * (1.f - 2.f * value);
+            destination[i] = (SampleType)(1.f - depth + depth * value);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i, phase += mPhaseIncrement)
+        {
+            auto value = readCubic(waveTable, warp(phase + mPhaseOffset));
+            value += invert * (1.f - 2.f * value);
+            destination[i] = (SampleType)(1.f - depth + depth * value);
+        }
+    }
+
+    mPhase = phase;
+}
+
+template void LFO::renderBlock<float>(float*, int) noexcept;
+template void LFO::renderBlock<double>(double*, int) noexcept;
+
 
 void LFO::getProcessorParams()
 {
-    mRate = rateParam->get();
-    //mRelativePhase = relativePhaseParam->get() / 360.0f;
-    mRelativePhase = relativePhaseParam->get();
+    getShapeParams();
+    getTimingParams();
+}
+
+/* Parameters which change the shape of the cycle */
+void LFO::getShapeParams()
+{
     //mDepth = depthParam->get() / 100.0f;
     mDepth = depthParam->get();
     mSymmetry = symmetryParam->get();
-
     mInvert = invertParam->get();
-    mIsSyncedToHost = syncToHostParam->get();
+    mWaveShapeChoice = waveshapeParam->getIndex();
+}
 
+/* Parameters which only affect the read-back of the wavetable */
+void LFO::getTimingParams()
+{
+    mRate = rateParam->get();
+    //mRelativePhase = relativePhaseParam->get() / 360.0f;
+    mRelativePhase = relativePhaseParam->get();
+    mIsSyncedToHost = syncToHostParam->get();
     mMultiplierChoice = multiplierParam->getIndex();
-    mWaveShapeChoice = waveshapeParam->getIndex();
 }
 
 
@@ -121,11 +226,15 @@ void LFO::setTempo(float hostBPM, double sampleRate)
     // Get the Relative Phase Shift
     //////mRelativePhase = relativePhaseParam->get() / 360.0f;
 
-    // Phase Shift is + / - 180 Degrees
+    // Phase Shift is + / - 180 Degrees, expressed against two table-lengths (the Oscilloscope's reference)
     if (mRelativePhase <= 0)    // 0 to +180
-        mRelativePhaseInSamples = abs( (mRelativePhase/360.0f)) * sampleRate;
+        mRelativePhaseInSamples = abs( (mRelativePhase/360.0f)) * 2 * waveTableSize;
     else                        // 0 to -180
-        mRelativePhaseInSamples = sampleRate * (1 - (mRelativePhase/360.0f) );
+        mRelativePhaseInSamples = 2 * waveTableSize * (1 - (mRelativePhase/360.0f) );
+
+    // Read-time phase offset, wrapped into one table length
+    auto offsetInCycles = mRelativePhaseInSamples / (double)waveTableSize;
+    mRelativePhaseOffset = (juce::uint32)((offsetInCycles - std::floor(offsetInCycles)) * cyclesToPhase);
 
 
     //////switch (multiplierParam->getIndex())     // Convert Multiplier Choice into Float
@@ -139,275 +248,57 @@ void LFO::setTempo(float hostBPM, double sampleRate)
         case 5: mMultiplierValue = 4.0f; break;
     }
 
+    // Cycles per second
+    double frequency;
+
     if (mIsSyncedToHost)  // LFO rate is BPM * Rhythm
-        mIncrement = (mHostBPM / (60.0f*wtScalar)) * mMultiplierValue;    // Converting
+        frequency = (mHostBPM / 60.0) * mMultiplierValue;    // Converting
     else
-        mIncrement = mRate / wtScalar;
-
-}
-
-
-
-
-
-
-/* Called when change in LFO shape is prompted */
-//==============================================================================
-void LFO::calculateWaveShape(double sampleRate)
-{
-    using namespace juce;
-
-    auto waveTableSize = sampleRate / wtScalar;
-
-    /* Get the Symmetry(Skew) Parameter and convert into sample-lengths of each period */
-    //////mSymmetry = symmetryParam->get();
-    
-    auto periodLeft = waveTableSize * mSymmetry / 100.f;            // Convert Symmetry Float into Sample Ranges
-    auto periodRight = waveTableSize * (1 - mSymmetry / 100.0f);    // Convert Symmetry Float into Sample Ranges
-
-    /* Get the Depth selection */
-    //////mDepth = depthParam->get() / 100.0f;
-
-    /* Check whether the LFO should be inverted or not */
-    //////mInvert = invertParam->get();
-    
-    switch (mInvert)
-    {
-        case 0: mInvertValue = 1.f; break;
-        case 1: mInvertValue = -1.f; break;
-    }
-    
-    /* Check for waveshape selection and update wavetable */
-    //////mWaveShapeChoice = waveshapeParam->getIndex();
-    
-    switch (mWaveShapeChoice)
-    {
-        case 0: setWaveShapeRampDown    (periodLeft, periodRight, waveTableSize); break;
-        case 1: setWaveShapeRampUp      (periodLeft, periodRight, waveTableSize); break;
-        case 2: setWaveShapeSquare      (periodLeft, periodRight, waveTableSize); break;
-        case 3: setWaveShapeTriangle    (periodLeft, periodRight, waveTableSize); break;
-        case 4: setWaveShapeSine        (periodLeft, periodRight, waveTableSize); break;
-        case 5: setWaveShapeHumpUp      (periodLeft, periodRight, waveTableSize); break;
-        case 6: setWaveShapeHumpDown    (periodLeft, periodRight, waveTableSize); break;
-    }
-
-    /* Map waveshape amplitudes from [-0.5 to +0.5] to [0 to +1] */
-    scaleWaveShape();
-
-}
-
-
-
-
-
-
-/* Set LFO waveshape to 'Ramp Down' */
-//==============================================================================
-void LFO::setWaveShapeRampDown(int periodLeft, int periodRight, int waveTableSize)
-{
-    float deltaDown = 0.01f;
-
-    for (float i = 0; i < waveTableSize; i++)
-    {
-        // Corner-Rounding Function
-        float y = ((1 / atan(1 / deltaDown)) * atan(sin(juce::MathConstants<double>::pi * (i) / waveTableSize) / deltaDown));
-
-        // Waveshape Function
-        float x;
-
-        // Populate the Left-Hand Period
-        if (i < periodLeft)
-            x = mInvertValue * (1 + (0.5f) * (-i / periodLeft));
-
-        // Populate the Right-Hand Period
-        if (i >= periodLeft)
-            x = mInvertValue * ((0.5f) + (0.5f) * (-(i - periodLeft) / (periodRight)));
-
-        waveTable.set(i, y * x);
-    }
-}
-
-/* Set LFO waveshape to 'Ramp Up' */
-//==============================================================================
-void LFO::setWaveShapeRampUp(int periodLeft, int periodRight, int waveTableSize)
-{
-    float deltaUp = 0.01f;          // Constant for Edge Rounding
-    
-    for (float i = 0; i < waveTableSize; i++)
-    {
-        // Corner-Rounding Function
-        float y = ((1 / atan(1 / deltaUp)) * atan(sin(juce::MathConstants<double>::pi * (i) / waveTableSize) / deltaUp));
-
-        // Waveshape Function
-        float x;
-
-        // Populate the Left-Hand Period
-        if (i < periodLeft)
-            x = mInvertValue * ((0.5f) * (i / periodLeft));
-
-        // Populate the Right-Hand Period
-        if (i >= periodLeft)
-            x = mInvertValue * ((0.5f) + (0.5f) * (i - periodLeft) / (periodRight));
-
-        waveTable.set(i, x * y);
-    }
-}
-
-/* Set LFO waveshape to 'Square' */
-//==============================================================================
-void LFO::setWaveShapeSquare(int periodLeft, int periodRight, int waveTableSize)
-{
-    float deltaPulse = 0.01f;    // Rounding Function
-
-    for (float i = 0; i < periodLeft; i++)
-    {
-        float y = mInvertValue * (0.5 + ((0.5 / atan(1 / deltaPulse)) * atan(sin(juce::MathConstants<double>::pi* i / periodLeft) / deltaPulse)));
-        waveTable.set(i, y);
-    }
-    for (float i = periodLeft; i < waveTableSize; i++)
-    {
-        float y = mInvertValue * (0.5 - ((0.5 / atan(1 / deltaPulse)) * atan(sin(juce::MathConstants<double>::pi * (i - periodLeft) / periodRight) / deltaPulse)));
-        waveTable.set(i, y);
-    }
-}
+        frequency = mRate;
 
-/* Set LFO waveshape to 'Triangle' */
-//==============================================================================
-void LFO::setWaveShapeTriangle(int periodLeft, int periodRight, int waveTableSize)
-{
-    // Populate the Left-Hand Period
-    for (int i = 0; i < periodLeft; i++)
-    {
-        float y = mInvertValue * ((i / (float)periodLeft));
-        waveTable.set(i, y);
-    }
+    if (sampleRate > 0)
+        mPhaseIncrement = (juce::uint32)(frequency / sampleRate * cyclesToPhase);
 
-    // Populate the Right-Hand Period
-    for (int i = periodLeft; i < waveTableSize; i++)
-    {
-        float y = mInvertValue * ((1.f - ((i - (float)periodLeft) / (float)periodRight)));
-        waveTable.set(i, y);
-    }
+    updatePhaseOffset();
 }
 
-/* Set LFO waveshape to 'Sine' */
+/* Called whenever the processor's latency changes, e.g. on switching crossover mode */
 //==============================================================================
-void LFO::setWaveShapeSine(int periodLeft, int periodRight, int waveTableSize)
+void LFO::setLatencyCompensation(int numSamples)
 {
-    // Populate the Left-Hand Period
-    for (int i = 0; i < periodLeft; i++)
-    {
-        float y = mInvertValue * ((0.5f) + (0.5f) * sin(juce::MathConstants<double>::pi * i / (periodLeft)));
-        waveTable.set(i, y);
-    }
-
-    // Populate the Right-Hand Period
-    for (int i = periodLeft; i < waveTableSize; i++)
-    {
-        float y = mInvertValue * ((0.5f) + (0.5f) * -sin(juce::MathConstants<double>::pi * (i - periodLeft) / (periodRight)));
-        waveTable.set(i, y);
-    }
+    mLatencySamples = numSamples;
+    updatePhaseOffset();
 }
 
-/* Set LFO waveshape to 'Hump Down' ... U-Shape */
+/* The compensation is a whole number of phase increments, so it follows any change of rate.
+   The accumulator wraps, so subtracting past zero lands on the right place in the previous cycle */
 //==============================================================================
-void LFO::setWaveShapeHumpUp(int periodLeft, int periodRight, int waveTableSize)
+void LFO::updatePhaseOffset()
 {
-    // Populate the Left-Hand Period
-    for (int i = 0; i < periodLeft; i++)
-    {
-        float y = mInvertValue * (sin(0.5f * juce::MathConstants<double>::pi * i / (periodLeft)));
-        waveTable.set(i, y);
-
-    }
-
-    // Populate the Right-Hand Period
-    for (int i = periodLeft; i < waveTableSize; i++)
-    {
-        float y = mInvertValue * (cos(0.5f * juce::MathConstants<double>::pi * (i - periodLeft) / (periodRight)));
-        waveTable.set(i, y);
-    }
+    mPhaseOffset = mRelativePhaseOffset - mPhaseIncrement * (juce::uint32)mLatencySamples;
 }
 
-/* Set LFO waveshape to 'Hump Up' ... Upsidedown U-Shape */
-//==============================================================================
-void LFO::setWaveShapeHumpDown(int periodLeft, int periodRight, int waveTableSize)
-{
-    // Populate the Left-Hand Period
-    for (int i = 0; i < periodLeft; i++)
-    {
-        float y = mInvertValue * ((-sin(0.5f * juce::MathConstants<double>::pi* i / (periodLeft)) + 1));
-        waveTable.set(i, y);
-    }
-
-    // Populate the Right-Hand Period
-    for (int i = periodLeft; i < waveTableSize; i++)
-    {
-        float y = mInvertValue * ((-cos(0.5f * juce::MathConstants<double>::pi * (i - periodLeft) / (periodRight)) + 1));
-        waveTable.set(i, y);
-    }
-}
 
 
 
 
 
-
-/* Maps waveshape amplitudes from [-0.5 to +0.5] to [0 to +1]
- Determines current minimum and maximum amplitude values
- and scales those to fit proportionately within [0, +1] */
+/* Renders a low-resolution cycle for the Oscilloscope, straight at the target shape */
 //==============================================================================
-void LFO::scaleWaveShape()
+juce::Array<float>& LFO::getWaveTableForDisplay(int amountToDownSample)
 {
-    min = 2.0f;
-    max = -1.0f;
+    waveTableForDisplay.resize(waveTableSize / amountToDownSample);
 
-    for (int sample = 0; sample < waveTable.size(); sample++)
-    {
-        if (waveTable[sample] < min)
-            min = waveTable[sample];
-
-        if (waveTable[sample] > max)
-            max = waveTable[sample];
-    }
+    const auto* table = waveTableBank->getTable(mWaveShapeChoice);
+    const Warp warp(mSymmetry / 100.f);
+    const auto invert = mInvert != 0 ? 1.f : 0.f;
+    const auto phaseIncrement = (juce::uint32)(cyclesToPhase / waveTableForDisplay.size());
 
-    /* Scale so max value is always 1; minimum value is 1 minus amplitude */
-    for (int i = 0; i < waveTable.size(); i++)
+    for (int i = 0; i < waveTableForDisplay.size(); ++i)
     {
-        float value = juce::jmap<float>(waveTable[i], min, max, 1.0f - (mDepth/100.f), 1.0f);
-        waveTableMapped.set(i, value);
+        auto value = readLinear(table, warp(phaseIncrement * (juce::uint32)i));
+        waveTableForDisplay.set(i, value + invert * (1.f - 2.f * value));
     }
-}
-
-/* Downsamples the WaveTable and returns to Oscilloscope */
-//==============================================================================
-juce::Array<float>& LFO::getWaveTableForDisplay(int amountToDownSample)
-{
-    
-    //for (int i = 0; i < 25; i++)
-        //DBG("");
 
-    auto waveTableSize = waveTable.size() / amountToDownSample;
-    
-    for (int i = 0; i < waveTableSize; i++)
-    {
-        auto value = waveTable[i*amountToDownSample];
-        waveTableForDisplay.set(i, value);
-        //DBG(value);
-    }
-    
-    //for (int i = 0; i < 25; i++)
-        //DBG("");
-
-    // Hard print the first value
-    auto firstValue = waveTable[0];
-    waveTableForDisplay.set(0, firstValue);
-    
-    // Hard print the last value
-    auto lastValue = waveTable[waveTable.size()-1];
-    waveTableForDisplay.set(waveTableForDisplay.size()-1, lastValue);
-    
     return waveTableForDisplay;
 }
-
-
@@ -10,6 +10,7 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "WaveTableBank.h"
 
 /* Instance of LFO which drives the amplitude modulation of its corresponding audio path */
 struct LFO
@@ -38,20 +39,60 @@ public:
     void initializeLFO(double sampleRate);
     void updateLFO(double sampleRate, double hostBPM);
 
+    /* Shape changes never touch a table: they select a bank table and retarget the read-time glides */
+    void updateShape();                 // Audio thread: O(1), refreshes waveshape, depth, symmetry and invert
+    void updateTempo(double hostBPM);   // Audio thread: refreshes rate, rhythm and phase only
+
 
     float getHostBPM() { return mHostBPM; }
 
     float getSampleRate() { return mSampleRate; }
 
-    float getWaveTableSize() { return waveTableMapped.size(); }
-
-    float getIncrement() { return mIncrement; }
-
-    float getPosition() { return mPosition; }
-    void setPosition(float newPosition) { mPosition = newPosition; }
+    /* Tables are a fixed power-of-two length, independent of sample rate, so
+       the read position wraps with a mask rather than fmod */
+    static constexpr int waveTableOrder = WaveTableBank::tableOrder;
+    static constexpr int waveTableSize = WaveTableBank::tableSize;
+    static constexpr juce::uint32 waveTableMask = waveTableSize - 1;
+
+    float getWaveTableSize() { return waveTableSize; }
+
+    enum class Interpolation { linear, cubic };
+    void setInterpolation(Interpolation newInterpolation) { mInterpolation = newInterpolation; }
+
+    /* Read-back position as a fraction of one cycle [0, 1) */
+    double getPhase() { return mPhase * phaseToCycles; }
+    void setPhase(double newPhase);
+
+    /* Reads the current amplitude and advances the phase accumulator by one sample */
+    inline float getNextSample() noexcept
+    {
+        auto value = readShaped(mPhase + mPhaseOffset,
+                                Warp(symmetryGlide.getNextValue()),
+                                invertGlide.getNextValue(),
+                                depthGlide.getNextValue());
+        mPhase += mPhaseIncrement;
+        return value;
+    }
+
+    /* Writes the next numSamples amplitudes into destination. Instantiated for float and double */
+    template <typename SampleType>
+    void renderBlock(SampleType* destination, int numSamples) noexcept;
+
+    /* Advances the phase and glides without reading, to stay in sync while the output is unused */
+    void advance(int numSamples) noexcept
+    {
+        mPhase += mPhaseIncrement * (juce::uint32)numSamples;
+        depthGlide.skip(numSamples);
+        symmetryGlide.skip(numSamples);
+        invertGlide.skip(numSamples);
+    }
 
     void setDsp(bool isProcessor) { isLinkedToDsp = isProcessor; }
 
+    /* Reads the cycle this many samples behind the accumulator. When the gain curve lands on audio that a
+       latent stage has delayed, the host shifts both back by the reported latency and they meet on the grid */
+    void setLatencyCompensation(int numSamples);
+
 
 
 
@@ -86,13 +127,7 @@ public:
 
 
 
-    /* Returns the waveTable to AudioProcessor as [0, 1] */
-    juce::Array<float>& getWaveTableScaled() { return waveTableMapped; }
-
-    /* Returns the waveTable to Display as [-0.5 to +0.5] */
-    juce::Array<float>& getWaveTable() { return waveTable; }
-
-    /* Downsamples the WaveTable and returns to Oscilloscope */
+    /* Returns one cycle to the Oscilloscope as [0, 1], with symmetry and invert but not depth applied */
     juce::Array<float>& getWaveTableForDisplay(int amountToDownSample);
 
 private:
@@ -101,11 +136,19 @@ private:
 
     bool isLinkedToDsp{ true };
 
-    juce::Array<float> waveTable;           // Array to store raw LFO waveshape
-    juce::Array<float> waveTableMapped;     // Mapped copy of waveTable so that max is always 1.0
-    juce::Array<float> waveTableForDisplay; // Downsampled copy of waveTable
+    /* Canonical waveshapes, shared by every LFO in the process */
+    juce::SharedResourcePointer<WaveTableBank> waveTableBank;
+
+    const float* waveTable{ nullptr };      // Bank table for the selected waveshape. Never written.
+
+    juce::Array<float> waveTableForDisplay; // Low-resolution cycle for the Oscilloscope
+
+    /* Read-time shaping, ramped per sample so automation never steps */
+    static constexpr double shapeGlideSeconds = 0.02;
+    juce::SmoothedValue<float> depthGlide{ 1.f };       // [0, 1]
+    juce::SmoothedValue<float> symmetryGlide{ 0.5f };   // Fraction of the cycle taken by the left-hand period
+    juce::SmoothedValue<float> invertGlide{ 0.f };      // 0 is upright, 1 is inverted
 
-    int wtScalar{ 2 };          // Used to set the size of the LFO WaveTable
 
 
 
@@ -120,30 +163,101 @@ private:
     float mRelativePhase = 0.f;       // Used to shift phase of LFO relative to others
     float mRelativePhaseInSamples = 0.f;       // Used to shift phase of LFO relative to others
     int mInvert{ 1 };               // 0 or 1 boolean.
-    float mInvertValue{ 1.f };      // -1 or +1.  Multiplied by the WaveTable to invert or not.
     int mWaveShapeChoice{ 0 };      // Used to select which of 7 waveforms are used
     int mMultiplierChoice = 1;      // Rhythm of LFO timing (Rename to Rhythm)
     bool mIsSyncedToHost{ false };
     float mRate{ 1.0f };            // Stores the current LFO rate.
 
-
-    float min{ 2.0f };          // Used to Map LFO Amplitudes
-    float max{ -1.0f };         // Used to Map LFO Amplitudes
-    float mIncrement = 1.f;     // Amount By Which To Increment In LFO Cycle
-    float mPosition = 0.f;      // Used by processBlock to note the current position in reading the LFO cycle.
+    /* Fixed-point phase accumulator. One full cycle spans the entire 32-bit range,
+       so the top waveTableOrder bits index the table and the rest are the fraction */
+    static constexpr int fractionBits = 32 - waveTableOrder;
+    static constexpr juce::uint32 fractionMask = (1u << fractionBits) - 1;
+    static constexpr float fractionScale = 1.f / (float)(1u << fractionBits);
+    static constexpr double cyclesToPhase = 4294967296.0;
+    static constexpr double phaseToCycles = 1.0 / cyclesToPhase;
+
+    juce::uint32 mPhase{ 0 };           // Used by processBlock to note the current position in reading the LFO cycle.
+    juce::uint32 mPhaseIncrement{ 0 }; // Amount By Which To Increment In LFO Cycle
+    juce::uint32 mPhaseOffset{ 0 };    // Relative phase shift less latency compensation, applied at read time
+    juce::uint32 mRelativePhaseOffset{ 0 };
+    int mLatencySamples{ 0 };
+
+    Interpolation mInterpolation{ Interpolation::linear };
+
+    /* Maps a phase in the LFO's cycle onto the bank table. The bank's left half is stretched over
+       the first `symmetry` of the cycle and its right half over the rest */
+    struct Warp
+    {
+        explicit Warp(float symmetry) noexcept
+            : split((juce::uint32)(symmetry * cyclesToPhase)),
+              leftScale(0.5f / symmetry),
+              rightScale(0.5f / (1.f - symmetry))
+        {
+        }
+
+        inline juce::uint32 operator()(juce::uint32 phase) const noexcept
+        {
+            return phase < split ? (juce::uint32)((float)phase * leftScale)
+                                 : halfCycle + (juce::uint32)((float)(phase - split) * rightScale);
+        }
+
+        static constexpr juce::uint32 halfCycle = 1u << 31;
+
+        juce::uint32 split;
+        float leftScale, rightScale;
+    };
+
+    inline float readWaveTable(const float* table, juce::uint32 phase) const noexcept
+    {
+        return mInterpolation == Interpolation::linear ? readLinear(table, phase)
+                                                       : readCubic(table, phase);
+    }
+
+    /* Bank tables are normalised, so invert is a complement and depth maps [0, 1] onto [1 - depth, 1] */
+    inline float readShaped(juce::uint32 phase, const Warp& warp, float invert, float depth) const noexcept
+    {
+        auto value = readWaveTable(waveTable, warp(phase));
+        value += invert * (1.f - 2.f * value);
+
+        return 1.f - depth + depth * value;
+    }
+
+    static inline float readLinear(const float* table, juce::uint32 phase) noexcept
+    {
+        auto index = phase >> fractionBits;
+        auto frac = (float)(phase & fractionMask) * fractionScale;
+
+        auto y0 = table[index];
+        auto y1 = table[(index + 1) & waveTableMask];
+
+        return y0 + frac * (y1 - y0);
+    }
+
+    /* 4-point, 3rd-order Hermite */
+    static inline float readCubic(const float* table, juce::uint32 phase) noexcept
+    {
+        auto index = phase >> fractionBits;
+        auto frac = (float)(phase & fractionMask) * fractionScale;
+
+        auto ym1 = table[(index - 1) & waveTableMask];
+        auto y0 = table[index];
+        auto y1 = table[(index + 1) & waveTableMask];
+        auto y2 = table[(index + 2) & waveTableMask];
+
+        auto c1 = 0.5f * (y1 - ym1);
+        auto c2 = ym1 - 2.5f * y0 + 2.f * y1 - 0.5f * y2;
+        auto c3 = 0.5f * (y2 - ym1) + 1.5f * (y0 - y1);
+
+        return ((c3 * frac + c2) * frac + c1) * frac + y0;
+    }
     float mMultiplierValue;       // Converts mMultiplierChoice into mathematical value
 
 
     void getProcessorParams();
+    void getShapeParams();
+    void getTimingParams();
+    void applyShape(bool skipGlides);
 
     void setTempo(float hostBPM, double sampleRate);
-    void calculateWaveShape(double sampleRate);
-    void scaleWaveShape();
-    void setWaveShapeRampDown(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeRampUp(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeSquare(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeTriangle(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeSine(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeHumpUp(int periodLeft, int periodRight, int waveTableSize);
-    void setWaveShapeHumpDown(int periodLeft, int periodRight, int waveTableSize);
+    void updatePhaseOffset();
 };
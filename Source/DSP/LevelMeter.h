@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 17 Oct 2026 5:10:37pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Measures one pick-off point: sample peak, 300 ms RMS, 4x-oversampled true-peak and
+   EBU R128 momentary / short-term loudness. Peak and sum of squares are one vectorised pass
+   over each meter channel; the K-weighting filters are recursive, so they run sample by sample,
+   with the channels side by side in SIMD lanes.
+   RMS and loudness are kept in windows of their own, independent of how the host or the
+   processor's sub-blocks split the audio.
+   The audio thread publishes a Snapshot after every block through a sequence lock,
+   so the GUI always reads a consistent set of values and never blocks the audio thread */
+class LevelMeter
+{
+public:
+    static constexpr int numMeterChannels = 2;     // Channels shown on the meters. Mono is shown on both
+
+    /* Levels in dB, with meter ballistics: instant rise, releaseSeconds fall */
+    struct Snapshot
+    {
+        std::array<float, numMeterChannels> peak;      // dBFS
+        std::array<float, numMeterChannels> rms;       // dBFS
+        std::array<float, numMeterChannels> truePeak;  // dBTP
+        float momentaryLoudness;                       // LUFS, 400 ms window
+        float shortTermLoudness;                       // LUFS, 3 s window
+    };
+
+    static constexpr float floorDecibels = -100.f;
+    static constexpr double releaseSeconds = 0.5;
+
+    void prepare(double sampleRate, int numChannels, int maximumBlockSize);
+    void reset();
+
+    /* Audio thread. Instantiated for float and double */
+    template <typename SampleType>
+    void process(const juce::AudioBuffer<SampleType>& buffer) noexcept;
+
+    /* Audio thread. Lets the levels fall without measuring input that is known to be silent */
+    void decay(int numSamples) noexcept;
+
+    /* Any thread */
+    Snapshot getSnapshot() const noexcept;
+
+private:
+   #if JUCE_USE_SIMD
+    using Vector = juce::dsp::SIMDRegister<float>;
+   #else
+    using Vector = float;
+   #endif
+
+    /* Channels K-weighted together in one register */
+    static constexpr int numLanes = (int)(sizeof(Vector) / sizeof(float));
+
+    static Vector splat(float value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return Vector::expand(value);
+       #else
+        return value;
+       #endif
+    }
+
+    static float sumLanes(Vector value) noexcept
+    {
+       #if JUCE_USE_SIMD
+        return value.sum();
+       #else
+        return value;
+       #endif
+    }
+
+    /* Stage of the BS.1770 K-weighting filter, transposed direct form II */
+    struct Biquad
+    {
+        float b0{ 1 }, b1{ 0 }, b2{ 0 }, a1{ 0 }, a2{ 0 };
+    };
+
+    /* Both stages' state, for one channel in each lane */
+    struct KWeightingState
+    {
+        Vector s1, s2, s3, s4;
+    };
+
+    template <typename SampleType>
+    void measureSegment(const juce::AudioBuffer<SampleType>& buffer, int startSample, int numSamples) noexcept;
+
+    /* Peak magnitude, and sum of squares added to sumOfSquares */
+    static float measurePeakAndPower(const float* samples, int numSamples, float& sumOfSquares) noexcept;
+
+    /* Advances the loudness and RMS windows by one segment, closing any that fill */
+    int getSegmentLength(int numRemaining) const noexcept;
+    void advanceWindows(int numSamples) noexcept;
+
+    void measureTruePeak(int meterChannel, int numSamples) noexcept;
+    void closeLoudnessBlock() noexcept;
+    void closeRmsSlice() noexcept;
+    void applyBallistics(int numSamples) noexcept;
+    void publish() noexcept;
+
+    static float toDecibels(float gain) noexcept { return juce::Decibels::gainToDecibels(gain, floorDecibels); }
+
+    /* K-weighting */
+    Biquad shelf, highpass;
+    std::vector<KWeightingState> kWeightingStates;      // One per group of numLanes channels
+    std::vector<Vector> kWeightingLanes;                // One group's segment, interleaved
+    int numChannels{ 0 };
+
+    /* Loudness is measured in 100 ms blocks; momentary spans 4 of them and short-term 30 */
+    static constexpr int numMomentaryBlocks = 4;
+    static constexpr int numShortTermBlocks = 30;
+    std::array<double, numShortTermBlocks> blockEnergies{};
+    int blockEnergyIndex{ 0 };
+    int samplesPerLoudnessBlock{ 4800 };
+    int loudnessBlockPosition{ 0 };
+    double loudnessBlockEnergy{ 0 };
+    float momentaryLoudness{ floorDecibels }, shortTermLoudness{ floorDecibels };
+
+    /* True-peak: 48-tap polyphase interpolator, 12 taps for each of the 4 phases */
+    static constexpr int oversamplingFactor = 4;
+    static constexpr int tapsPerPhase = 12;
+    std::array<std::array<float, tapsPerPhase>, oversamplingFactor> phaseTaps;     // Stored reversed, for a straight dot product
+    std::array<std::vector<float>, numMeterChannels> truePeakScratch;              // History, then the current block
+
+    /* RMS is measured over rmsWindowSeconds, made of numRmsSlices slices, and updated as each slice ends */
+    static constexpr double rmsWindowSeconds = 0.3;
+    static constexpr int numRmsSlices = 10;
+    std::array<std::array<float, numRmsSlices>, numMeterChannels> sliceEnergies{};
+    std::array<float, numMeterChannels> sliceSumOfSquares{}, rmsLevel{};
+    int rmsSliceIndex{ 0 };
+    int samplesPerRmsSlice{ 1440 };
+    int rmsSlicePosition{ 0 };
+
+    /* Per-block measurements of the meter channels */
+    std::array<float, numMeterChannels> blockPeak{}, blockTruePeak{};
+
+    /* Ballistics, in dB */
+    std::array<juce::LinearSmoothedValue<float>, numMeterChannels> peakLevels, rmsLevels, truePeakLevels;
+
+    /* Sequence lock. Odd while the audio thread is writing */
+    static constexpr int numSnapshotValues = (int)(sizeof(Snapshot) / sizeof(float));
+    std::atomic<juce::uint32> sequence{ 0 };
+    std::array<std::atomic<float>, numSnapshotValues> publishedValues{};
+};
@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.cpp
+    Created: 17 Oct 2026 11:40:18am
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseCrossover.h"
+
+//==============================================================================
+LinearPhaseCrossover::LinearPhaseCrossover()
+    : juce::Thread("Linear Phase Crossover Designer")
+{
+    for (size_t i = 0; i < targetFrequencies.size(); ++i)
+        targetFrequencies[i].store(1000.f);
+}
+
+LinearPhaseCrossover::~LinearPhaseCrossover()
+{
+    stopThread(1000);
+}
+
+//==============================================================================
+void LinearPhaseCrossover::setNumBands(int newNumBands)
+{
+    numBands = juce::jlimit(minBands, maxBands, newNumBands);
+}
+
+/* Housekeeping PRIOR TO audio processing */
+//==============================================================================
+void LinearPhaseCrossover::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    stopThread(1000);
+
+    sampleRate = spec.sampleRate;
+    kernelSize = 2 * juce::nextPowerOfTwo((int)std::ceil(sampleRate * kernelSeconds)) + 1;
+
+    window.resize((size_t)kernelSize);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(),
+                                                             (size_t)kernelSize,
+                                                             juce::dsp::WindowingFunction<float>::blackman,
+                                                             false);
+
+    /* One convolver per band and channel pair. Only rebuilt when the layout changes */
+    auto newNumChannelPairs = ((int)spec.numChannels + 1) / 2;
+
+    if (newNumChannelPairs != numChannelPairs || (int)convolvers.size() != numBands * newNumChannelPairs)
+    {
+        numChannelPairs = newNumChannelPairs;
+        convolvers.clear();
+
+        for (int i = 0; i < numBands * numChannelPairs; ++i)
+            convolvers.push_back(std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::Latency{ 0 }, convolutionQueue));
+    }
+
+    /* Queue the kernels first: Convolution::prepare() runs any queued loads and builds its engine from them,
+       so the first block after prepare() already filters with these kernels rather than a stale or default one */
+    designPending.store(false);
+    designKernels();
+
+    auto pairSpec = spec;
+    pairSpec.numChannels = juce::jmin(2u, spec.numChannels);
+
+    for (auto& convolver : convolvers)
+        convolver->prepare(pairSpec);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        bands[(size_t)band].setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+        doubleBands[(size_t)band].setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+    }
+
+    floatInput.setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+
+    startThread();
+}
+
+//==============================================================================
+void LinearPhaseCrossover::reset()
+{
+    for (auto& convolver : convolvers)
+        convolver->reset();
+}
+
+//==============================================================================
+void LinearPhaseCrossover::setCrossoverFrequency(int crossoverIndex, float frequency)
+{
+    jassert(juce::isPositiveAndBelow(crossoverIndex, numBands - 1));
+
+    auto& target = targetFrequencies[(size_t)crossoverIndex];
+
+    if (target.load() != frequency)
+    {
+        target.store(frequency);
+
+        // Wake the designer once per design, however many moves arrive before it runs
+        if (!designPending.exchange(true))
+            notify();
+    }
+}
+
+/* Runs each band kernel straight from the input into its band buffer */
+//==============================================================================
+void LinearPhaseCrossover::process(const juce::AudioBuffer<float>& input)
+{
+    auto numChannels = input.getNumChannels();
+    auto numSamples = input.getNumSamples();
+
+    auto inputBlock = juce::dsp::AudioBlock<const float>(input.getArrayOfReadPointers(),
+                                                         (size_t)numChannels,
+                                                         (size_t)numSamples);
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        auto& bandBuffer = bands[(size_t)band];
+        bandBuffer.setSize(numChannels, numSamples, false, false, true);
+
+        auto bandBlock = juce::dsp::AudioBlock<float>(bandBuffer);
+
+        for (int pair = 0; pair < numChannelPairs; ++pair)
+        {
+            auto firstChannel = (size_t)(pair * 2);
+            auto numPairChannels = juce::jmin((size_t)2, (size_t)numChannels - firstChannel);
+
+            auto pairInput = inputBlock.getSubsetChannelBlock(firstChannel, numPairChannels);
+            auto pairOutput = bandBlock.getSubsetChannelBlock(firstChannel, numPairChannels);
+
+            getConvolver(band, pair).process(juce::dsp::ProcessContextNonReplacing<float>(pairInput, pairOutput));
+        }
+    }
+}
+
+//==============================================================================
+void LinearPhaseCrossover::process(const juce::AudioBuffer<double>& input)
+{
+    floatInput.makeCopyOf(input, true);
+
+    process(floatInput);
+
+    for (int band = 0; band < numBands; ++band)
+        doubleBands[(size_t)band].makeCopyOf(bands[(size_t)band], true);
+}
+
+/* Background thread: sleeps until a crossover moves, then redesigns the kernels.
+   In Linkwitz-Riley mode nothing moves it, so it never wakes */
+//==============================================================================
+void LinearPhaseCrossover::run()
+{
+    while (!threadShouldExit())
+    {
+        if (designPending.exchange(false))
+            designKernels();
+        else
+            wait(-1);
+    }
+}
+
+/* Band 0 is the first lowpass, band i is lowpass i minus lowpass i - 1, and the top band
+   is a centred impulse minus the last lowpass. The bands therefore sum to a pure delay.
+   Convolution crossfades to the new kernels itself, so a moving crossover doesn't click */
+//==============================================================================
+void LinearPhaseCrossover::designKernels()
+{
+    juce::AudioBuffer<float> previousLowpass(1, kernelSize);
+    juce::AudioBuffer<float> lowpass(1, kernelSize);
+    previousLowpass.clear();
+
+    for (int band = 0; band < numBands; ++band)
+    {
+        if (band < numBands - 1)
+        {
+            fillLowpass(lowpass.getWritePointer(0), targetFrequencies[(size_t)band].load());
+        }
+        else
+        {
+            lowpass.clear();
+            lowpass.setSample(0, kernelSize / 2, 1.f);
+        }
+
+        juce::AudioBuffer<float> kernel(1, kernelSize);
+        juce::FloatVectorOperations::subtract(kernel.getWritePointer(0),
+                                              lowpass.getReadPointer(0),
+                                              previousLowpass.getReadPointer(0),
+                                              kernelSize);
+
+        for (int pair = 0; pair < numChannelPairs; ++pair)
+        {
+            auto pairKernel = kernel;   // Each convolver takes ownership of its own copy
+
+            getConvolver(band, pair).loadImpulseResponse(std::move(pairKernel),
+                                                         sampleRate,
+                                                         juce::dsp::Convolution::Stereo::no,
+                                                         juce::dsp::Convolution::Trim::no,
+                                                         juce::dsp::Convolution::Normalise::no);
+        }
+
+        std::swap(previousLowpass, lowpass);
+    }
+}
+
+/* Windowed-sinc lowpass, scaled for unity gain at DC */
+//==============================================================================
+void LinearPhaseCrossover::fillLowpass(float* destination, float cutoff) const
+{
+    auto normalisedCutoff = juce::jlimit(0.0, 0.49, cutoff / sampleRate);
+    auto centre = kernelSize / 2;
+    auto sum = 0.0;
+
+    for (int n = 0; n < kernelSize; ++n)
+    {
+        auto x = (double)(n - centre);
+        auto sinc = n == centre ? 2.0 * normalisedCutoff
+                                : std::sin(juce::MathConstants<double>::twoPi * normalisedCutoff * x) / (juce::MathConstants<double>::pi * x);
+
+        destination[n] = (float)(sinc * window[(size_t)n]);
+        sum += destination[n];
+    }
+
+    juce::FloatVectorOperations::multiply(destination, (float)(1.0 / sum), kernelSize);
+}
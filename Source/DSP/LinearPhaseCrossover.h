@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 17 Oct 2026 11:40:18am
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Splits a signal into bands with linear-phase FIR filters.
+   Band kernels are differences of windowed-sinc lowpasses, so they sum to a pure delay.
+   Kernels are redesigned on a background thread, which sleeps until a crossover moves, and run through
+   uniform-partitioned FFT convolution, which costs the same on every block.
+   Convolution handles at most two channels, so wider layouts run one convolver per channel pair */
+class LinearPhaseCrossover : private juce::Thread
+{
+public:
+    static constexpr int minBands = 2;
+    static constexpr int maxBands = 8;
+
+    LinearPhaseCrossover();
+    ~LinearPhaseCrossover() override;
+
+    /* Call before prepare() */
+    void setNumBands(int newNumBands);
+    int getNumBands() const { return numBands; }
+
+    /* Designs the first set of kernels synchronously. Call while audio is stopped */
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    /* Audio thread. Only requests a redesign when the frequency actually changes */
+    void setCrossoverFrequency(int crossoverIndex, float frequency);
+
+    void process(const juce::AudioBuffer<float>& input);
+
+    /* Convolution is single precision, so double input is converted at the engine's boundary */
+    void process(const juce::AudioBuffer<double>& input);
+
+    template <typename SampleType = float>
+    juce::AudioBuffer<SampleType>& getBand(int bandIndex)
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleBands[(size_t)bandIndex];
+        else
+            return bands[(size_t)bandIndex];
+    }
+
+    /* Group delay of every band kernel */
+    int getLatencyInSamples() const { return kernelSize / 2; }
+
+    /* How long an impulse keeps ringing out of the bands, latency included */
+    int getKernelSize() const { return kernelSize; }
+
+private:
+    void run() override;
+
+    void designKernels();
+    void fillLowpass(float* destination, float cutoff) const;
+
+    int numBands{ 3 };
+
+    double sampleRate{ 44100.0 };
+    int kernelSize{ 1 };                    // Always odd, so the group delay is a whole number of samples
+    std::vector<float> window;
+
+    std::array<std::atomic<float>, maxBands - 1> targetFrequencies;
+    std::atomic<bool> designPending{ false };      // Set by the audio thread; the designer sleeps until it is
+
+    int numChannelPairs{ 0 };
+
+    /* All convolvers load their kernels through one shared background queue */
+    juce::dsp::ConvolutionMessageQueue convolutionQueue;
+    std::vector<std::unique_ptr<juce::dsp::Convolution>> convolvers;   // [band * numChannelPairs + pair]
+    juce::dsp::Convolution& getConvolver(int band, int pair) { return *convolvers[(size_t)(band * numChannelPairs + pair)]; }
+    std::array<juce::AudioBuffer<float>, maxBands> bands;
+
+    juce::AudioBuffer<float> floatInput;                        // Double-precision path only
+    std::array<juce::AudioBuffer<double>, maxBands> doubleBands; // Double-precision path only
+
+    static constexpr double kernelSeconds = 0.04;  // Half-length of the kernels, rounded up to a power of two
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LinearPhaseCrossover)
+};
@@ -13,91 +13,85 @@
 
 //==============================================================================
 
+/* Single-producer, single-consumer ring of samples. One thread writes, one thread reads,
+   and neither ever blocks or allocates once the size is set */
+template <typename SampleType>
 class LockFreeQueue
 {
 
 public:
 
-    ScopedPointer<AbstractFifo> lockFreeFifo;
-    Array<float> data;
+    std::unique_ptr<AbstractFifo> lockFreeFifo;
+    Array<SampleType> data;
     int lastReadPos = 0;
 
     LockFreeQueue()
     {
-        lockFreeFifo = new AbstractFifo(512);
+        lockFreeFifo = std::make_unique<AbstractFifo>(512);
 
-        //clear
-        data.ensureStorageAllocated(512);
-        FloatVectorOperations::clear(data.getRawDataPointer(), 512);
-
-        while (data.size() < 512)
-        {
-            data.add(0.f);
-        }
+        data.insertMultiple(0, SampleType(), 512);
     }
 
+    /* Not thread-safe. Call before either side starts */
     void setTotalSize(int newSize)
     {
         lockFreeFifo->setTotalSize(newSize);
 
         // clear
-        data.ensureStorageAllocated(newSize);
-        FloatVectorOperations::clear(data.getRawDataPointer(), newSize);
-
-        while (data.size() < newSize)
-        {
-            data.add(0.f);
-        }
+        data.clearQuick();
+        data.insertMultiple(0, SampleType(), newSize);
     }
 
-    void writeTo(const float* writeData, int numToWrite)
+    /* Producer. Writes as much as fits; anything that doesn't is dropped. Returns the number written */
+    int writeTo(const SampleType* writeData, int numToWrite)
     {
         int start1, start2, blockSize1, blockSize2;
 
         lockFreeFifo->prepareToWrite(numToWrite, start1, blockSize1, start2, blockSize2);
 
-        if (blockSize1 > 0) FloatVectorOperations::copy(data.getRawDataPointer() + start1, writeData, blockSize1);
-        if (blockSize2 > 0) FloatVectorOperations::copy(data.getRawDataPointer() + start2, writeData + blockSize1, blockSize2);
+        if (blockSize1 > 0) std::copy(writeData, writeData + blockSize1, data.getRawDataPointer() + start1);
+        if (blockSize2 > 0) std::copy(writeData + blockSize1, writeData + blockSize1 + blockSize2, data.getRawDataPointer() + start2);
 
         // MOVE the FIFO write head...
-        lockFreeFifo->finishedWrite(numToWrite);
+        lockFreeFifo->finishedWrite(blockSize1 + blockSize2);
 
+        return blockSize1 + blockSize2;
     }
 
-    void readFrom(float* readData, int numToRead)
+    /* Consumer */
+    void readFrom(SampleType* readData, int numToRead)
     {
         int start1, blockSize1, start2, blockSize2;
         lockFreeFifo->prepareToRead(numToRead, start1, blockSize1, start2, blockSize2);
 
         if (blockSize1 > 0)
         {
-            FloatVectorOperations::copy(readData, data.getRawDataPointer() + start1, blockSize1);
+            std::copy(data.getRawDataPointer() + start1, data.getRawDataPointer() + start1 + blockSize1, readData);
             lastReadPos = start1 + blockSize1;
         }
 
         if (blockSize2 > 0)
         {
-            FloatVectorOperations::copy(readData + blockSize1, data.getRawDataPointer() + start2, blockSize2);
+            std::copy(data.getRawDataPointer() + start2, data.getRawDataPointer() + start2 + blockSize2, readData + blockSize1);
             lastReadPos = start2 + blockSize2;
         }
 
         lockFreeFifo->finishedRead(blockSize1 + blockSize2);
     }
 
-    void readMostRecent(float* readData, int numToRead)
+    /* Consumer. Drops the oldest samples without reading them */
+    void discard(int numToDiscard)
     {
-
+        lockFreeFifo->finishedRead(juce::jmin(numToDiscard, getNumReady()));
     }
 
-    int writeToArray(Array<float>* dest, int destPos)
+    int writeToArray(Array<SampleType>* dest, int destPos)
     {
         // Append any new data to a circular array
 
         // DRAIN the excess
-        while (getNumReady() > dest->size())
-        {
-            lockFreeFifo->finishedRead(getNumReady() - dest->size());
-        }
+        if (getNumReady() > dest->size())
+            discard(getNumReady() - dest->size());
 
         // READ latest data from the LFQ
         const int numToAppend = getNumReady();
@@ -117,9 +111,14 @@ public:
         return numToAppend;
     }
 
-    int getNumReady()
+    int getNumReady() const
     {
         return lockFreeFifo->getNumReady();
     }
 
+    int getFreeSpace() const
+    {
+        return lockFreeFifo->getFreeSpace();
+    }
+
 };
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    ParameterDispatcher.cpp
+    Created: 17 Oct 2026 4:22:10pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "ParameterDispatcher.h"
+
+//==============================================================================
+ParameterDispatcher::~ParameterDispatcher()
+{
+    for (auto* parameter : parameters)
+        parameter->removeListener(this);
+}
+
+/* The only place the lookup table grows, so callbacks never see it resize */
+//==============================================================================
+void ParameterDispatcher::add(juce::AudioProcessorParameter* parameter, Mask flags)
+{
+    jassert(parameter != nullptr);
+
+    auto index = parameter->getParameterIndex();
+    jassert(index >= 0);    // Must already belong to a processor
+
+    if ((size_t)index >= flagsByIndex.size())
+        flagsByIndex.resize((size_t)index + 1, 0);
+
+    if (flagsByIndex[(size_t)index] == 0)
+    {
+        parameters.push_back(parameter);
+        parameter->addListener(this);
+    }
+
+    flagsByIndex[(size_t)index] |= flags;
+}
+
+/* May be called on the audio thread during automation */
+//==============================================================================
+void ParameterDispatcher::parameterValueChanged(int parameterIndex, float)
+{
+    if (juce::isPositiveAndBelow(parameterIndex, (int)flagsByIndex.size()))
+        markDirty(flagsByIndex[(size_t)parameterIndex]);
+}
@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    ParameterDispatcher.h
+    Created: 17 Oct 2026 4:22:10pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Turns parameter changes into bits of an atomic dirty mask, for the audio thread to consume once per block.
+   Parameters are resolved to their processor index when added, so a change notification is one
+   table lookup and one atomic OR: no strings, locks or allocation, whichever thread it arrives on */
+class ParameterDispatcher : private juce::AudioProcessorParameter::Listener
+{
+public:
+    using Mask = juce::uint64;
+
+    ParameterDispatcher() = default;
+    ~ParameterDispatcher() override;
+
+    /* Message thread, before any audio. Any change to parameter will set flags */
+    void add(juce::AudioProcessorParameter* parameter, Mask flags);
+
+    /* Audio thread: returns everything flagged since the last call, and clears it */
+    Mask consume() noexcept { return dirty.exchange(0, std::memory_order_acquire); }
+
+    void markDirty(Mask flags) noexcept { dirty.fetch_or(flags, std::memory_order_release); }
+
+private:
+    void parameterValueChanged(int parameterIndex, float newValue) override;
+    void parameterGestureChanged(int, bool) override {}
+
+    std::vector<juce::AudioProcessorParameter*> parameters;
+    std::vector<Mask> flagsByIndex;     // Indexed by AudioProcessorParameter::getParameterIndex()
+
+    std::atomic<Mask> dirty{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ParameterDispatcher)
+};
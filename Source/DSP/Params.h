@@ -20,6 +20,7 @@ namespace Params    // Mapping between Parameter Names and Unique ID's
 
 		Low_Mid_Crossover_Freq,
 		Mid_High_Crossover_Freq,
+		Crossover_Mode,
 
 		Bypass_Low_Band,
 		Bypass_Mid_Band,
@@ -77,7 +78,14 @@ namespace Params    // Mapping between Parameter Names and Unique ID's
 		Scope_Point2,
 
 		Show_FFT,
-		FFT_Pickoff
+		FFT_Pickoff,
+		Show_Band_FFT,
+		FFT_Size,
+		FFT_Window,
+		FFT_Overlap,
+		FFT_Zero_Padding,
+
+		Sub_Block_Size
 	};
 
 	inline const std::map<Names, juce::String>& GetParams()
@@ -89,6 +97,7 @@ namespace Params    // Mapping between Parameter Names and Unique ID's
 
 			{Low_Mid_Crossover_Freq,    "Low-Mid Crossover Freq"},
 			{Mid_High_Crossover_Freq,   "Mid-High Crossover Freq"},
+			{Crossover_Mode,            "Crossover Mode"},
 
 			{Bypass_Low_Band,           "Bypassed Low Band" },
 			{Bypass_Mid_Band,           "Bypassed Mid Band" },
@@ -147,6 +156,13 @@ namespace Params    // Mapping between Parameter Names and Unique ID's
 
 			{Show_FFT,					"Show FFT"},
 			{FFT_Pickoff,				"FFT Pickoff Point" },
+			{Show_Band_FFT,				"Show Band FFT" },
+			{FFT_Size,					"FFT Size" },
+			{FFT_Window,				"FFT Window" },
+			{FFT_Overlap,				"FFT Overlap" },
+			{FFT_Zero_Padding,			"FFT Zero Padding" },
+
+			{Sub_Block_Size,			"Sub-Block Size" },
 		};
 
 		return params;
@@ -0,0 +1,334 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.cpp
+    Created: 17 Oct 2026 6:48:15pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "SpectrumAnalyzer.h"
+#include <numeric>
+
+/* One byte per field, so the settings travel between threads as a single atomic word */
+//==============================================================================
+juce::uint32 SpectrumAnalyzer::Settings::pack() const noexcept
+{
+    return (juce::uint32)fftOrder
+         | (juce::uint32)window << 8
+         | (juce::uint32)overlapOrder << 16
+         | (juce::uint32)paddingOrder << 24;
+}
+
+SpectrumAnalyzer::Settings SpectrumAnalyzer::Settings::unpack(juce::uint32 packed) noexcept
+{
+    Settings unpacked;
+    unpacked.fftOrder = juce::jlimit(minFftOrder, maxFftOrder, (int)(packed & 0xff));
+    unpacked.window = (Window)((packed >> 8) & 0xff);
+    unpacked.overlapOrder = juce::jlimit(0, maxOverlapOrder, (int)((packed >> 16) & 0xff));
+    unpacked.paddingOrder = juce::jlimit(0, maxPaddingOrder, (int)((packed >> 24) & 0xff));
+
+    return unpacked;
+}
+
+/* Only the frames handed to the message thread are sized here. Everything that depends on
+   the settings is left to configure(), on the worker, once the first trace is switched on */
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer(std::initializer_list<AnalyzerFeed*> feedsToAnalyse, int numDisplayPoints)
+    : juce::Thread("Spectrum Analyzer"),
+    numPoints(numDisplayPoints),
+    frameLevels((size_t)numPoints, 0.f)
+{
+    jassert(feedsToAnalyse.size() <= sizeof(TraceMask) * 8);
+
+    for (auto* feed : feedsToAnalyse)
+    {
+        traceStates.push_back({ feed,
+                                {}, 0, 0,
+                                std::vector<float>((size_t)numPoints, 0.f),
+                                std::vector<float>((size_t)numPoints, 0.f),
+                                std::vector<float>((size_t)numPoints, 0.f) });
+    }
+
+    for (auto& frame : frames)
+    {
+        frame.traces.resize(traceStates.size());
+
+        for (auto& trace : frame.traces)
+        {
+            trace.levels.assign((size_t)numPoints, 0.f);
+            trace.peaks.assign((size_t)numPoints, 0.f);
+        }
+    }
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer()
+{
+    stopThread(1000);
+}
+
+/* The thread is only started the first time it is needed, and is woken whenever the traces change */
+//==============================================================================
+void SpectrumAnalyzer::setActiveTraces(TraceMask traces)
+{
+    if (activeTraces.exchange(traces) == traces)
+        return;
+
+    if (traces != 0)
+    {
+        if (!isThreadRunning())
+            startThread();
+
+        notify();
+    }
+}
+
+/* Swaps the front frame for the middle one, if the worker has published since the last call */
+//==============================================================================
+bool SpectrumAnalyzer::acquireLatestFrame() noexcept
+{
+    if ((middleFrame.load(std::memory_order_acquire) & newFrameFlag) == 0)
+        return false;
+
+    frontFrame = middleFrame.exchange(frontFrame, std::memory_order_acq_rel) & ~newFrameFlag;
+
+    return true;
+}
+
+//==============================================================================
+void SpectrumAnalyzer::run()
+{
+    TraceMask analysedTraces = 0;   // Those active on the last pass
+
+    double busyMs = 0;
+    auto loadWindowStart = juce::Time::getMillisecondCounterHiRes();
+
+    while (!threadShouldExit())
+    {
+        auto traces = activeTraces.load();
+
+        if (traces == 0)
+        {
+            analysedTraces = 0;
+            cpuLoad = 0.f;
+            wait(-1);
+
+            busyMs = 0;
+            loadWindowStart = juce::Time::getMillisecondCounterHiRes();
+            continue;
+        }
+
+        auto passStart = juce::Time::getMillisecondCounterHiRes();
+
+        /* New settings: every trace starts again */
+        auto requestedSettings = getSettings();
+
+        if (requestedSettings != settings || forwardFFT == nullptr)
+        {
+            configure(requestedSettings);
+            analysedTraces = 0;
+
+            busyMs = 0;
+            loadWindowStart = passStart;
+        }
+
+        /* A trace which has just been switched on publishes straight away, and one switched off disappears */
+        bool changed = traces != analysedTraces;
+
+        for (int i = 0; i < getNumTraces(); ++i)
+        {
+            if ((traces & traceBit(i)) == 0)
+                continue;
+
+            auto& trace = traceStates[(size_t)i];
+
+            /* Whatever queued up while it was off is stale */
+            if ((analysedTraces & traceBit(i)) == 0)
+                restart(trace);
+
+            while (!threadShouldExit() && pullFrame(trace))
+            {
+                analyseFrame(trace);
+                changed = true;
+            }
+        }
+
+        analysedTraces = traces;
+
+        if (changed)
+        {
+            writeFrame(frames[(size_t)backFrame], traces);
+            publishFrame();
+        }
+
+        /* CPU load: time spent working over wall-clock time */
+        auto now = juce::Time::getMillisecondCounterHiRes();
+        busyMs += now - passStart;
+
+        if (now - loadWindowStart >= loadWindowMs)
+        {
+            cpuLoad = (float)(busyMs / (now - loadWindowStart));
+            busyMs = 0;
+            loadWindowStart = now;
+        }
+
+        wait(pollIntervalMs);
+    }
+}
+
+/* Worker thread. Sizes everything which depends on the settings */
+//==============================================================================
+void SpectrumAnalyzer::configure(const Settings& newSettings)
+{
+    settings = newSettings;
+
+    auto frameSize = settings.getFrameSize();
+    auto transformSize = settings.getTransformSize();
+
+    forwardFFT = std::make_unique<juce::dsp::FFT>(settings.fftOrder + settings.paddingOrder);
+    fftData.assign((size_t)(2 * transformSize), 0.f);
+
+    windowTable.resize((size_t)frameSize);
+    juce::dsp::WindowingFunction<float>::fillWindowingTables(windowTable.data(), (size_t)frameSize, settings.window, false);
+
+    /* A full-scale sine peaks at half the window's sum, so every window reads it at 0 dB */
+    referenceMagnitude = 0.5f * std::accumulate(windowTable.begin(), windowTable.end(), 0.f);
+
+    for (auto& trace : traceStates)
+        trace.history.assign((size_t)frameSize, 0.f);
+}
+
+/* Worker thread. Starts the trace again from silence */
+//==============================================================================
+void SpectrumAnalyzer::restart(TraceState& trace) noexcept
+{
+    trace.feed->flush();
+
+    std::fill(trace.history.begin(), trace.history.end(), 0.f);
+    trace.historyIndex = 0;
+    trace.samplesSinceFrame = 0;
+
+    std::fill(trace.smoothedLevels.begin(), trace.smoothedLevels.end(), 0.f);
+    std::fill(trace.peakLevels.begin(), trace.peakLevels.end(), 0.f);
+    std::fill(trace.peakHoldRemaining.begin(), trace.peakHoldRemaining.end(), 0.f);
+}
+
+/* Worker thread. Drains the feed into the trace's history, up to the next hop. Once a hop has
+   arrived, unrolls the history into fftData, oldest sample first, and returns true. If the feed
+   holds more than a frame, the excess is skipped and the frame rebuilt from the newest audio */
+//==============================================================================
+bool SpectrumAnalyzer::pullFrame(TraceState& trace) noexcept
+{
+    auto& feed = *trace.feed;
+    auto frameSize = settings.getFrameSize();
+    auto hopSize = settings.getHopSize();
+    auto numReady = feed.getNumReady();
+
+    if (numReady > frameSize)
+    {
+        feed.discard(numReady - frameSize);
+        numReady = frameSize;
+        trace.samplesSinceFrame = hopSize - frameSize;
+    }
+
+    auto numToRead = juce::jmin(numReady, hopSize - trace.samplesSinceFrame);
+    auto numToEnd = juce::jmin(numToRead, frameSize - trace.historyIndex);
+
+    feed.read(trace.history.data() + trace.historyIndex, numToEnd);
+    feed.read(trace.history.data(), numToRead - numToEnd);
+
+    trace.historyIndex = (trace.historyIndex + numToRead) & (frameSize - 1);
+    trace.samplesSinceFrame += numToRead;
+
+    if (trace.samplesSinceFrame < hopSize)
+        return false;
+
+    trace.samplesSinceFrame = 0;
+
+    auto oldest = trace.history.begin() + trace.historyIndex;
+    std::copy(oldest, trace.history.end(), fftData.begin());
+    std::copy(trace.history.begin(), oldest, fftData.begin() + (trace.history.end() - oldest));
+
+    return true;
+}
+
+/* Worker thread. Transforms the frame in fftData and folds it into the trace's smoothed and peak levels.
+   Levels rise instantly and fall at a fixed rate in dB, so each frame moves them by one hop's worth */
+//==============================================================================
+void SpectrumAnalyzer::analyseFrame(TraceState& trace) noexcept
+{
+    auto frameSize = settings.getFrameSize();
+    auto transformSize = settings.getTransformSize();
+
+    // Zero-padding, and whatever the last transform left behind
+    std::fill(fftData.begin() + frameSize, fftData.end(), 0.f);
+
+    // Apply Window Function to Data
+    juce::FloatVectorOperations::multiply(fftData.data(), windowTable.data(), frameSize);
+
+    // Render FFT Data
+    forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());
+
+    auto sampleRate = currentSampleRate.load();
+
+    if (!mapper.isPreparedFor(sampleRate, transformSize, numPoints))
+        mapper.prepare(sampleRate, transformSize, numPoints);
+
+    mapper.process(fftData.data(), frameLevels.data(), referenceMagnitude, minDecibels, maxDecibels);
+
+    auto frameSeconds = (float)(settings.getHopSize() / sampleRate);
+    auto decibelRange = maxDecibels - minDecibels;
+    auto fall = fallDecibelsPerSecond * frameSeconds / decibelRange;
+    auto peakFall = peakFallDecibelsPerSecond * frameSeconds / decibelRange;
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto level = frameLevels[(size_t)i];
+
+        auto& smoothed = trace.smoothedLevels[(size_t)i];
+        smoothed = juce::jmax(level, smoothed - fall);
+
+        auto& peak = trace.peakLevels[(size_t)i];
+        auto& hold = trace.peakHoldRemaining[(size_t)i];
+
+        if (smoothed >= peak)
+        {
+            peak = smoothed;
+            hold = peakHoldSeconds;
+        }
+        else if (hold > 0.f)
+        {
+            hold -= frameSeconds;
+        }
+        else
+        {
+            peak = juce::jmax(smoothed, peak - peakFall);
+        }
+    }
+}
+
+/* Only active traces are copied; the others keep whatever they last held */
+//==============================================================================
+void SpectrumAnalyzer::writeFrame(Frame& destination, TraceMask traces) const noexcept
+{
+    for (int i = 0; i < getNumTraces(); ++i)
+    {
+        auto& trace = destination.traces[(size_t)i];
+        trace.isActive = (traces & traceBit(i)) != 0;
+
+        if (!trace.isActive)
+            continue;
+
+        const auto& state = traceStates[(size_t)i];
+        std::copy(state.smoothedLevels.begin(), state.smoothedLevels.end(), trace.levels.begin());
+        std::copy(state.peakLevels.begin(), state.peakLevels.end(), trace.peaks.begin());
+    }
+}
+
+/* Swaps the finished back frame into the middle slot and takes back whichever frame was there */
+//==============================================================================
+void SpectrumAnalyzer::publishFrame() noexcept
+{
+    backFrame = middleFrame.exchange(backFrame | newFrameFlag, std::memory_order_acq_rel) & ~newFrameFlag;
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    SpectrumAnalyzer.h
+    Created: 17 Oct 2026 6:48:15pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "AnalyzerFeed.h"
+#include "SpectrumMapper.h"
+
+/* Background worker which turns the audio from one or more AnalyzerFeeds into ready-to-draw spectra:
+   framing, window, FFT, mapping onto log-spaced display points, smoothing and peak-hold.
+   Each feed is one trace. The FFT, window and mapping table are shared by all of them,
+   and traces which aren't shown are neither analysed nor, if the audio thread checks, fed.
+   Frame size, window, overlap and zero-padding can be changed at any time; every buffer they
+   size lives here and is reallocated on the worker thread. Finished frames are handed to the
+   message thread through a lock-free triple buffer, so drawing only ever reads a completed
+   frame and never waits for the worker */
+class SpectrumAnalyzer : private juce::Thread
+{
+public:
+    using TraceMask = juce::uint32;
+
+    /* Display levels in [0, 1], covering minDecibels to maxDecibels,
+       at points log-spaced from SpectrumMapper::minFrequency to maxFrequency */
+    struct Trace
+    {
+        std::vector<float> levels;      // Smoothed spectrum
+        std::vector<float> peaks;       // Peak-hold
+        bool isActive{ false };         // Inactive traces hold stale levels and shouldn't be drawn
+    };
+
+    struct Frame
+    {
+        std::vector<Trace> traces;      // In the order the feeds were given
+    };
+
+    struct Settings
+    {
+        using Window = juce::dsp::WindowingFunction<float>::WindowingMethod;
+
+        int fftOrder{ 12 };                         // Frames of 2^fftOrder samples
+        Window window{ Window::blackmanHarris };
+        int overlapOrder{ 1 };                      // Hop of one frame / 2^overlapOrder: none, 50%, 75%, 87.5%
+        int paddingOrder{ 0 };                      // Transform of one frame * 2^paddingOrder, zero-padded
+
+        int getFrameSize() const noexcept { return 1 << fftOrder; }
+        int getHopSize() const noexcept { return getFrameSize() >> overlapOrder; }
+        int getTransformSize() const noexcept { return getFrameSize() << paddingOrder; }
+
+        bool operator== (const Settings& other) const noexcept { return pack() == other.pack(); }
+        bool operator!= (const Settings& other) const noexcept { return pack() != other.pack(); }
+
+        juce::uint32 pack() const noexcept;
+        static Settings unpack(juce::uint32 packed) noexcept;
+    };
+
+    static constexpr int minFftOrder = 10;
+    static constexpr int maxFftOrder = 15;
+    static constexpr int maxOverlapOrder = 3;
+    static constexpr int maxPaddingOrder = 2;
+
+    static constexpr float minDecibels = -60.f;     // Relative to a full-scale sine
+    static constexpr float maxDecibels = 0.f;
+
+    static constexpr float fallDecibelsPerSecond = 48.f;        // Smoothed spectrum release
+    static constexpr float peakHoldSeconds = 1.f;
+    static constexpr float peakFallDecibelsPerSecond = 24.f;
+
+    SpectrumAnalyzer(std::initializer_list<AnalyzerFeed*> feedsToAnalyse, int numDisplayPoints);
+    ~SpectrumAnalyzer() override;
+
+    /* Before audio */
+    void prepare(double sampleRate) { currentSampleRate = sampleRate; }
+    double getSampleRate() const noexcept { return currentSampleRate.load(); }
+
+    /* Any thread. Applied by the worker before its next frame, restarting every trace */
+    void setSettings(const Settings& newSettings) noexcept { packedSettings = newSettings.pack(); }
+    Settings getSettings() const noexcept { return Settings::unpack(packedSettings.load()); }
+
+    /* Message thread. One bit per trace. The worker sleeps while none are active:
+       editor closed, or the spectrum hidden */
+    void setActiveTraces(TraceMask traces);
+
+    /* Any thread. The audio thread can skip feeding inactive traces */
+    bool isTraceActive(int trace) const noexcept { return (activeTraces.load(std::memory_order_relaxed) & traceBit(trace)) != 0; }
+
+    static constexpr TraceMask traceBit(int trace) { return TraceMask(1) << trace; }
+
+    /* Any thread. Share of one core the worker spent analysing over the last loadWindowMs, for the current settings */
+    float getCpuLoad() const noexcept { return cpuLoad.load(); }
+
+    /* Message thread. Picks up a newly completed frame, if any. Returns true if one arrived */
+    bool acquireLatestFrame() noexcept;
+
+    /* Message thread. The frame picked up by the last acquireLatestFrame() */
+    const Frame& getFrame() const noexcept { return frames[(size_t)frontFrame]; }
+
+    int getNumTraces() const noexcept { return (int)traceStates.size(); }
+    int getNumDisplayPoints() const noexcept { return numPoints; }
+
+private:
+    /* Worker thread only */
+    struct TraceState
+    {
+        AnalyzerFeed* feed;
+        std::vector<float> history;             // The last frame's worth of audio, circular
+        int historyIndex{ 0 };                  // Oldest sample, and where the next one goes
+        int samplesSinceFrame{ 0 };
+        std::vector<float> smoothedLevels, peakLevels, peakHoldRemaining;
+    };
+
+    void run() override;
+
+    void configure(const Settings& newSettings);
+    void restart(TraceState& trace) noexcept;
+    bool pullFrame(TraceState& trace) noexcept;
+    void analyseFrame(TraceState& trace) noexcept;
+    void writeFrame(Frame& destination, TraceMask traces) const noexcept;
+    void publishFrame() noexcept;
+
+    const int numPoints;
+
+    /* Worker thread only */
+    std::vector<TraceState> traceStates;
+    Settings settings;                          // As last configured
+    std::unique_ptr<juce::dsp::FFT> forwardFFT;
+    std::vector<float> windowTable;             // One frame
+    float referenceMagnitude{ 1.f };            // Peak bin of a full-scale sine, through this window
+    std::vector<float> fftData;                 // Twice the transform size, transformed in place
+    SpectrumMapper mapper;                      // Rebuilt when the sample rate or transform size changes
+    std::vector<float> frameLevels;
+
+    /* Triple buffer. The message thread reads the front frame, the worker writes the back frame,
+       and finished frames are exchanged through the middle slot. All three are sized up front */
+    std::array<Frame, 3> frames;
+    int frontFrame{ 0 };                        // Owned by the message thread
+    int backFrame{ 1 };                         // Owned by the worker
+    std::atomic<int> middleFrame{ 2 };          // Hand-off slot, tagged with newFrameFlag once published
+    static constexpr int newFrameFlag = 4;
+
+    std::atomic<TraceMask> activeTraces{ 0 };
+    std::atomic<juce::uint32> packedSettings{ Settings().pack() };
+    std::atomic<double> currentSampleRate{ 44100.0 };
+    std::atomic<float> cpuLoad{ 0.f };
+
+    int pollIntervalMs{ 10 };                   // Well inside what the feed can hold at any supported rate
+    static constexpr double loadWindowMs = 500.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyzer)
+};
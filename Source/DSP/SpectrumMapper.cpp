@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    SpectrumMapper.cpp
+    Created: 17 Oct 2026 7:31:52pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "SpectrumMapper.h"
+
+/* Point i sits at minFrequency * (maxFrequency / minFrequency)^(i / (numPoints - 1)),
+   and covers the bins from halfway to the point below, to halfway to the point above */
+//==============================================================================
+void SpectrumMapper::prepare(double sampleRate, int fftSize, int numPoints)
+{
+    jassert(sampleRate > 0 && fftSize > 0 && numPoints > 1);
+
+    preparedSampleRate = sampleRate;
+    preparedFftSize = fftSize;
+
+    points.resize((size_t)numPoints);
+    pooled.assign((size_t)numPoints, 0.f);
+
+    const auto nyquistBin = fftSize / 2;
+    const auto binsPerHertz = fftSize / sampleRate;
+    const auto octaves = std::log2((double)maxFrequency / minFrequency);
+
+    const auto binAt = [=](double point) { return minFrequency * std::exp2(octaves * point / (numPoints - 1)) * binsPerHertz; };
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto& point = points[(size_t)i];
+
+        auto centre = binAt(i);
+        auto first = (int)std::ceil(binAt(i - 0.5));
+        auto last = juce::jmin((int)std::floor(binAt(i + 0.5)), nyquistBin);
+
+        if (centre > nyquistBin)
+        {
+            point = { -1, 0, 0.f };
+        }
+        else if (last >= first)
+        {
+            point = { first, last - first + 1, 0.f };
+        }
+        else
+        {
+            auto below = juce::jmin((int)centre, nyquistBin - 1);
+            point = { below, 0, (float)(centre - below) };
+        }
+    }
+}
+
+//==============================================================================
+void SpectrumMapper::process(const float* magnitudes, float* levels, float referenceMagnitude, float minDecibels, float maxDecibels) noexcept
+{
+    const auto numPoints = (int)points.size();
+    auto* pool = pooled.data();
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto& point = points[(size_t)i];
+
+        if (point.firstBin < 0)
+            pool[i] = 0.f;
+        else if (point.numBins > 0)
+            pool[i] = juce::FloatVectorOperations::findMaximum(magnitudes + point.firstBin, point.numBins);
+        else
+            pool[i] = magnitudes[point.firstBin] + point.fraction * (magnitudes[point.firstBin + 1] - magnitudes[point.firstBin]);
+    }
+
+    /* 20 log10(m / referenceMagnitude), mapped onto [0, 1], folded into one multiply-add on log2(m) */
+    constexpr auto decibelsPerOctave = 6.020599913f;     // 20 log10(2)
+    const auto range = maxDecibels - minDecibels;
+    const auto scale = decibelsPerOctave / range;
+    const auto offset = (-decibelsPerOctave * std::log2(referenceMagnitude) - minDecibels) / range;
+
+    /* Anything this quiet is below the floor anyway; keeps log2 away from zero and denormals */
+    const auto floorMagnitude = referenceMagnitude * juce::Decibels::decibelsToGain(minDecibels - 20.f);
+    juce::FloatVectorOperations::max(pool, pool, floorMagnitude, numPoints);
+
+    for (int i = 0; i < numPoints; ++i)
+        levels[i] = log2Approx(pool[i]) * scale + offset;
+
+    juce::FloatVectorOperations::clip(levels, levels, 0.f, 1.f, numPoints);
+}
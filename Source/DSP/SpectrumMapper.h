@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    SpectrumMapper.h
+    Created: 17 Oct 2026 7:31:52pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Maps FFT magnitudes onto log-spaced display points between minFrequency and maxFrequency.
+   Each point covers the bins between its neighbours' midpoints: where that is several bins
+   they are max-pooled, so narrow peaks in the upper octaves are never skipped; where it is
+   less than one bin the two nearest bins are interpolated. The point-to-bin table is built once
+   per sample rate, FFT size and point count, so each frame is a table walk and one vector pass */
+class SpectrumMapper
+{
+public:
+    static constexpr float minFrequency = 20.f;
+    static constexpr float maxFrequency = 20000.f;
+
+    /* Rebuilds the table. Allocates, so never on the audio thread */
+    void prepare(double sampleRate, int fftSize, int numPoints);
+
+    bool isPreparedFor(double sampleRate, int fftSize, int numPoints) const noexcept
+    {
+        return sampleRate == preparedSampleRate && fftSize == preparedFftSize && numPoints == (int)points.size();
+    }
+
+    /* Magnitudes from FFT::performFrequencyOnlyForwardTransform. Writes one level per point in [0, 1],
+       covering minDecibels to maxDecibels, where 0 dB is referenceMagnitude */
+    void process(const float* magnitudes, float* levels, float referenceMagnitude, float minDecibels, float maxDecibels) noexcept;
+
+private:
+    struct Point
+    {
+        int firstBin;       // Negative above Nyquist
+        int numBins;        // Bins to max-pool. Zero to interpolate between firstBin and the next
+        float fraction;     // Interpolation position
+    };
+
+    /* log2(x) for positive, normal x. Branch-free, so the loops calling it vectorise.
+       Centres the mantissa on 1 and uses the atanh series: |error| < 1.1e-6, about 7e-6 dB */
+    static inline float log2Approx(float x) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        auto exponent = (int)(bits >> 23) - 127;
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        auto high = mantissa > juce::MathConstants<float>::sqrt2;
+        mantissa = high ? mantissa * 0.5f : mantissa;
+        exponent += high ? 1 : 0;
+
+        auto t = (mantissa - 1.f) / (mantissa + 1.f);
+        auto t2 = t * t;
+
+        // 2/ln(2) * (t + t^3/3 + t^5/5 + t^7/7)
+        return (float)exponent + t * (2.885390082f + t2 * (0.9617966940f + t2 * (0.5770780164f + t2 * 0.4121985831f)));
+    }
+
+    std::vector<Point> points;
+    std::vector<float> pooled;          // One magnitude per point
+
+    double preparedSampleRate{ 0 };
+    int preparedFftSize{ 0 };
+};
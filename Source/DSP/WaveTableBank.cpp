@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    WaveTableBank.cpp
+    Created: 17 Oct 2026 3:05:41pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "WaveTableBank.h"
+
+//==============================================================================
+WaveTableBank::WaveTableBank()
+{
+    storage.resize((size_t)numShapes * tableSize * sizeof(float) / sizeof(Vector));
+
+    for (int shape = 0; shape < numShapes; ++shape)
+    {
+        auto* table = getWritePointer(shape);
+
+        fillShape(shape, table);
+        normalise(table);
+    }
+}
+
+/* Generates one raw cycle. The first half of the table is the shape's left-hand period,
+   the second half its right-hand period, so the LFO can stretch either to set symmetry */
+//==============================================================================
+void WaveTableBank::fillShape(int shape, float* destination) noexcept
+{
+    constexpr auto half = tableSize / 2;
+    constexpr auto cycleScale = 1.f / tableSize;    // Index to [0, 1) within the whole table
+    constexpr auto halfScale = 1.f / half;          // Index to [0, 1) within the current half
+
+    /* Rounds the corners of the ramps and the square's edges */
+    constexpr auto delta = 0.01f;
+    const auto roundingScale = 1.f / std::atan(1.f / delta);
+
+    const auto rounding = [roundingScale](float u) noexcept { return atanPositive(sinPi(u) * (1.f / delta)) * roundingScale; };
+
+    switch (shape)
+    {
+        case rampDown:
+            for (int i = 0; i < tableSize; ++i)
+                destination[i] = (1.f - i * cycleScale) * rounding(i * cycleScale);
+            break;
+
+        case rampUp:
+            for (int i = 0; i < tableSize; ++i)
+                destination[i] = i * cycleScale * rounding(i * cycleScale);
+            break;
+
+        case square:
+            for (int i = 0; i < half; ++i)
+            {
+                destination[i]        = 0.5f + 0.5f * rounding(i * halfScale);
+                destination[i + half] = 0.5f - 0.5f * rounding(i * halfScale);
+            }
+            break;
+
+        case triangle:
+            for (int i = 0; i < half; ++i)
+            {
+                destination[i]        = i * halfScale;
+                destination[i + half] = 1.f - i * halfScale;
+            }
+            break;
+
+        case sine:
+            for (int i = 0; i < half; ++i)
+            {
+                destination[i]        = 0.5f + 0.5f * sinPi(i * halfScale);
+                destination[i + half] = 0.5f - 0.5f * sinPi(i * halfScale);
+            }
+            break;
+
+        case hills:     // cos(pi/2 * x) == sin(pi * (1 - x) / 2)
+            for (int i = 0; i < half; ++i)
+            {
+                destination[i]        = sinPi(0.5f * i * halfScale);
+                destination[i + half] = sinPi(0.5f - 0.5f * i * halfScale);
+            }
+            break;
+
+        case valleys:
+            for (int i = 0; i < half; ++i)
+            {
+                destination[i]        = 1.f - sinPi(0.5f * i * halfScale);
+                destination[i + half] = 1.f - sinPi(0.5f - 0.5f * i * halfScale);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/* Stretches the table so its minimum is 0 and its maximum is 1 */
+//==============================================================================
+void WaveTableBank::normalise(float* destination) noexcept
+{
+    auto range = juce::FloatVectorOperations::findMinAndMax(destination, tableSize);
+
+    if (range.getLength() <= 0.f)
+        return;
+
+    juce::FloatVectorOperations::add(destination, -range.getStart(), tableSize);
+    juce::FloatVectorOperations::multiply(destination, 1.f / range.getLength(), tableSize);
+}
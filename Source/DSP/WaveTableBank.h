@@ -0,0 +1,93 @@
+/*
+  ==============================================================================
+
+    WaveTableBank.h
+    Created: 17 Oct 2026 3:05:41pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/* Canonical LFO waveshapes, built once and shared by every LFO in the process.
+   Hold one through juce::SharedResourcePointer<WaveTableBank>; the bank is built when
+   the first pointer is created and freed when the last one goes away.
+   Each table is one cycle at 50% symmetry, not inverted, normalised to [0, 1].
+   Symmetry, invert and depth are applied by the LFO on top of these */
+class WaveTableBank
+{
+public:
+    /* Same order as the waveshape choices in createParameterLayout() */
+    enum Shape
+    {
+        rampDown = 0,
+        rampUp,
+        square,
+        triangle,
+        sine,
+        hills,
+        valleys,
+        numShapes
+    };
+
+    static constexpr int tableOrder = 12;
+    static constexpr int tableSize = 1 << tableOrder;
+
+    WaveTableBank();
+
+    /* Read-only for the lifetime of the bank, so any thread may read without locking */
+    const float* getTable(int shape) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(shape, (int)numShapes));
+        return reinterpret_cast<const float*>(storage.data()) + shape * tableSize;
+    }
+
+    /* Largest difference from the original std::sin / std::atan tables allowed after normalising.
+       Checked for every shape and sample by the wavetables benchmark in Benchmarks/ */
+    static constexpr float maxGeneratorError = 1.0e-6f;
+
+private:
+   #if JUCE_USE_SIMD
+    using Vector = juce::dsp::SIMDRegister<float>;
+   #else
+    using Vector = float;
+   #endif
+
+    float* getWritePointer(int shape) noexcept { return reinterpret_cast<float*>(storage.data()) + shape * tableSize; }
+
+    /* Each shape is generated by its own branch-free loop, so the compiler can vectorise it */
+    static void fillShape(int shape, float* destination) noexcept;
+    static void normalise(float* destination) noexcept;
+
+    /* sin(pi * u) for u in [0, 1] */
+    static inline float sinPi(float u) noexcept
+    {
+        u = juce::jmin(u, 1.f - u);     // Symmetric about u = 0.5
+        auto u2 = u * u;
+
+        // Odd minimax polynomial on [0, 0.5]. Evaluated in float, |error| < 2.5e-7
+        return u * (3.141592580e+00f + u2 * (-5.167706878e+00f + u2 * (2.550031366e+00f
+                  + u2 * (-5.980451152e-01f + u2 * 7.722002552e-02f))));
+    }
+
+    /* atan(z) for z >= 0 */
+    static inline float atanPositive(float z) noexcept
+    {
+        auto r = juce::jmin(z, 1.f / juce::jmax(z, 1.f));   // Above 1, use atan(z) = pi/2 - atan(1/z)
+        auto r2 = r * r;
+
+        // Odd minimax polynomial on [0, 1]. Evaluated in float, |error| < 2e-7 for any z
+        auto p = r * (9.999993350e-01f + r2 * (-3.332985868e-01f + r2 * (1.994654247e-01f
+                    + r2 * (-1.390851776e-01f + r2 * (9.641921505e-02f + r2 * (-5.590869019e-02f
+                    + r2 * (2.186051976e-02f + r2 * -4.053914052e-03f)))))));
+
+        return z > 1.f ? juce::MathConstants<float>::halfPi - p : p;
+    }
+
+    /* All tables back to back, aligned for SIMD reads */
+    std::vector<Vector> storage;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveTableBank)
+};
@@ -135,14 +135,16 @@ void InputOutputGain::getLevels()
 
 	if (pickOffPoint == "INPUT")
 	{
-		leftLevel = audioProcessor.getRmsValue(0, 0);
-		rightLevel = audioProcessor.getRmsValue(0, 1);
+		auto levels = audioProcessor.getMeterSnapshot(0);
+		leftLevel = levels.rms[0];
+		rightLevel = levels.rms[1];
 	}
 
 	if (pickOffPoint == "OUTPUT")
 	{
-		leftLevel = audioProcessor.getRmsValue(1, 0);
-		rightLevel = audioProcessor.getRmsValue(1, 1);
+		auto levels = audioProcessor.getMeterSnapshot(1);
+		leftLevel = levels.rms[0];
+		rightLevel = levels.rms[1];
 	}
 
 	if (pickOffPoint == "NA")
@@ -90,6 +90,11 @@ void OptionsMenu::mouseEnter(const juce::MouseEvent& event)
 void OptionsMenu::mouseExit(const juce::MouseEvent& event)
 {
 
+    // A choice's popup is its own window, so the mouse leaves while it's open
+    for (const auto& option : optionsArray)
+        if (option->comboBox.isPopupActive())
+            return;
+
     if (!isMouseOver(true)) {
         closeDropdown();
         mHasFocus = false;
@@ -195,6 +200,40 @@ void OptionsMenu::addOptionToList(juce::String optionTitle,
     optionsArray.add(std::move(newOption)); // Transfers ownership to the array
 }
 
+// ========================================================
+void OptionsMenu::addChoiceToList(juce::String optionTitle,
+                                  juce::String optionDescription,
+                                  juce::AudioProcessorValueTreeState& apvts,
+                                  juce::String parameterID
+                                  )
+{
+
+    using namespace juce;
+
+    auto* choiceParam = dynamic_cast<AudioParameterChoice*>(apvts.getParameter(parameterID));
+    jassert(choiceParam != nullptr);
+
+    auto newOption = std::make_unique<OptionItem>();
+
+    newOption->optionTitle = optionTitle;
+    newOption->optionDescription = optionDescription;
+
+    // The attachment maps the parameter's index onto the item index, so the items must be in place first
+    newOption->comboBox.addItemList(choiceParam->choices, 1);
+    newOption->comboBox.setTooltip(optionTitle + ": " + optionDescription);
+
+    newOption->comboBox.setColour(    ComboBox::ColourIds::backgroundColourId, juce::Colours::white);
+    newOption->comboBox.setColour(    ComboBox::ColourIds::textColourId, juce::Colours::black);
+    newOption->comboBox.setColour(    ComboBox::ColourIds::arrowColourId, juce::Colours::black);
+    newOption->comboBox.setColour(    ComboBox::ColourIds::outlineColourId, juce::Colours::darkgrey);
+
+    newOption->choiceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts,
+                                                                                                           parameterID,
+                                                                                                           newOption->comboBox);
+
+    optionsArray.add(std::move(newOption)); // Transfers ownership to the array
+}
+
 // ========================================================
 void OptionsMenu::buildDropdown()
 {
@@ -216,9 +255,9 @@ void OptionsMenu::buildDropdown()
     
     for (const auto& option : optionsArray)
     {
-        flexBox.items.add( FlexItem(option->toggleButton).withHeight(height));
+        flexBox.items.add( FlexItem(option->getControl()).withHeight(height));
         flexBox.items.add(spacer);
-        addAndMakeVisible(option->toggleButton);
+        addAndMakeVisible(option->getControl());
     }
     
     flexBox.items.add(margin);
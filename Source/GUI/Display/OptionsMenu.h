@@ -16,11 +16,17 @@ struct OptionItem
 {
 public:
     juce::ToggleButton toggleButton;
+    juce::ComboBox comboBox;            // Used instead of the toggle for choice parameters
     juce::String optionTitle;
     juce::String optionDescription;
     
     using buttonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
     std::unique_ptr<buttonAttachment> optionAttachment;
+
+    using comboBoxAttachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    std::unique_ptr<comboBoxAttachment> choiceAttachment;
+
+    juce::Component& getControl() { return choiceAttachment != nullptr ? (juce::Component&)comboBox : toggleButton; }
 };
 
 
@@ -51,6 +57,12 @@ public:
                             juce::String optionDescription,
                             juce::AudioProcessorValueTreeState& apvts,
                             juce::String parameterID);
+
+    /* For choice parameters. Shows the current choice, and the title as its tooltip */
+    void addChoiceToList(   juce::String optionTitle,
+                            juce::String optionDescription,
+                            juce::AudioProcessorValueTreeState& apvts,
+                            juce::String parameterID);
     
 private:
     juce::TextButton mButtonOptions;
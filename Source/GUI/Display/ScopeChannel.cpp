@@ -17,11 +17,11 @@ ScopeChannel::ScopeChannel(juce::AudioProcessorValueTreeState& apvts, LFO& lfo,
     mSampleRate = apvts.processor.getSampleRate();
     mHostBpm = lfo.getHostBPM();
 
-    localLFO.initializeLFO(mSampleRate);
-
     if (mSampleRate == 0)
         mSampleRate = 48000;
 
+    localLFO.initializeLFO(mSampleRate);
+
     if (mHostBpm == 0 || mHostBpm == 1)
         mHostBpm = 120;
 
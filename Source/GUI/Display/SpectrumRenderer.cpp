@@ -0,0 +1,339 @@
+/*
+  ==============================================================================
+
+    SpectrumRenderer.cpp
+    Created: 17 Oct 2026 9:37:44pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#include "SpectrumRenderer.h"
+
+/* Anything sized to the old bounds is dropped; the column table waits for the next frame's point count */
+//==============================================================================
+void SpectrumRenderer::setBounds(juce::Rectangle<float> newBounds)
+{
+    if (newBounds == bounds)
+        return;
+
+    bounds = newBounds;
+
+    columns.clear();
+    numTablePoints = 0;
+    traces.clear();
+
+    buildGradient();
+    needsFullRepaint = true;
+}
+
+/* Columns run from 2 px inside the left edge to 2 px inside the right, one per pixel.
+   Where a column spans a point or more, those points are max-pooled so narrow peaks survive;
+   otherwise it is interpolated from the two points either side */
+//==============================================================================
+void SpectrumRenderer::buildColumns(int numPoints)
+{
+    columns.clear();
+    numTablePoints = numPoints;
+
+    auto numColumns = (int)bounds.getWidth() - 3;
+
+    if (numColumns < 2 || numPoints < 2)
+        return;
+
+    auto pointsPerColumn = (float)(numPoints - 1) / (float)(numColumns - 1);
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        auto position = (float)column * pointsPerColumn;
+
+        auto lo = juce::jmax(0, (int)std::ceil(position - 0.5f * pointsPerColumn));
+        auto hi = juce::jmin(numPoints - 1, (int)std::floor(position + 0.5f * pointsPerColumn));
+
+        if (pointsPerColumn >= 1.f && hi >= lo)
+        {
+            columns.push_back({ lo, hi - lo + 1, 0.f });
+        }
+        else
+        {
+            auto first = juce::jmin((int)position, numPoints - 2);
+            columns.push_back({ first, 0, position - (float)first });
+        }
+    }
+
+    scratch.assign(columns.size(), 0.f);
+}
+
+/* The fill gradient, drawn once per size in the drawing area's own coordinates */
+//==============================================================================
+void SpectrumRenderer::buildGradient()
+{
+    auto width = juce::roundToInt(bounds.getWidth());
+    auto height = juce::roundToInt(bounds.getHeight());
+
+    if (width <= 0 || height <= 0)
+    {
+        gradientImage = {};
+        return;
+    }
+
+    auto area = juce::Rectangle<float>((float)width, (float)height);
+
+    auto gradient = juce::ColourGradient(juce::Colours::grey,
+        area.getBottomLeft(),
+        juce::Colours::lightgrey,
+        area.getTopRight(), false);
+
+    gradient.addColour(0.25f, juce::Colours::white.withBrightness(1.25f));
+    gradient.addColour(0.5f, juce::Colours::whitesmoke.withBrightness(1.25f));
+
+    gradientImage = juce::Image(juce::Image::ARGB, width, height, false);
+
+    juce::Graphics g(gradientImage);
+    g.setGradientFill(gradient);
+    g.fillAll();
+}
+
+//==============================================================================
+void SpectrumRenderer::resample(const std::vector<float>& levels, std::vector<float>& ys) const noexcept
+{
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+        const auto& column = columns[i];
+        auto* source = levels.data() + column.firstPoint;
+
+        auto level = column.numPoints > 0
+            ? *std::max_element(source, source + column.numPoints)
+            : source[0] + column.fraction * (source[1] - source[0]);
+
+        ys[i] = toY(level);
+    }
+}
+
+/* Takes each trace's new columns, and collects the area between the old and new curves.
+   A changed column moves the segments to both its neighbours, so their heights count too */
+//==============================================================================
+juce::Rectangle<int> SpectrumRenderer::update(const SpectrumAnalyzer::Frame& frame)
+{
+    if (frame.traces.empty())
+        return {};
+
+    auto numPoints = (int)frame.traces.front().levels.size();
+
+    if (numPoints != numTablePoints)
+    {
+        buildColumns(numPoints);
+        traces.clear();
+    }
+
+    if (columns.empty())
+        return {};
+
+    auto numColumns = (int)columns.size();
+
+    if (traces.size() != frame.traces.size())
+    {
+        traces.assign(frame.traces.size(), {});
+
+        for (auto& trace : traces)
+        {
+            trace.levels.assign(columns.size(), toY(0.f));
+            trace.peaks.assign(columns.size(), toY(0.f));
+        }
+
+        needsFullRepaint = true;
+    }
+
+    auto top = bounds.getBottom();
+    auto bottom = bounds.getY();
+    auto firstChanged = numColumns;
+    auto lastChanged = -1;
+
+    auto merge = [&](std::vector<float>& stored)
+    {
+        for (int column = 0; column < numColumns; ++column)
+        {
+            auto newY = scratch[(size_t)column];
+            auto& oldY = stored[(size_t)column];
+
+            if (newY == oldY)
+                continue;
+
+            auto previous = stored[(size_t)juce::jmax(0, column - 1)];
+            auto next = stored[(size_t)juce::jmin(numColumns - 1, column + 1)];
+
+            top = juce::jmin(top, newY, oldY, juce::jmin(previous, next));
+            bottom = juce::jmax(bottom, newY, oldY, juce::jmax(previous, next));
+            firstChanged = juce::jmin(firstChanged, column);
+            lastChanged = juce::jmax(lastChanged, column);
+
+            oldY = newY;
+        }
+    };
+
+    for (size_t i = 0; i < traces.size(); ++i)
+    {
+        const auto& source = frame.traces[i];
+        auto& trace = traces[i];
+
+        if (source.isActive != trace.isActive)
+        {
+            trace.isActive = source.isActive;
+            needsFullRepaint = true;
+        }
+
+        if (!trace.isActive)
+            continue;
+
+        resample(source.levels, scratch);
+        merge(trace.levels);
+
+        // Only the filled trace shows its peaks
+        if (i == 0)
+        {
+            resample(source.peaks, scratch);
+            merge(trace.peaks);
+        }
+    }
+
+    if (needsFullRepaint)
+    {
+        needsFullRepaint = false;
+        return bounds.expanded(2.f).getSmallestIntegerContainer();
+    }
+
+    if (lastChanged < 0)
+        return {};
+
+    return juce::Rectangle<float>::leftTopRightBottom(getColumnX(firstChanged - 1), top, getColumnX(lastChanged + 1), bottom)
+        .expanded(2.f)
+        .getSmallestIntegerContainer();
+}
+
+//==============================================================================
+void SpectrumRenderer::addCurve(juce::Path& path, const std::vector<float>& ys, int first, int last) const
+{
+    path.startNewSubPath(getColumnX(first), ys[(size_t)first]);
+
+    for (int column = first + 1; column <= last; ++column)
+        path.lineTo(getColumnX(column), ys[(size_t)column]);
+}
+
+//==============================================================================
+void SpectrumRenderer::paint(juce::Graphics& g)
+{
+    if (traces.empty() || columns.empty())
+        return;
+
+    /* Only the columns that can be seen, plus one either side so the edge segments are whole */
+    auto numColumns = (int)columns.size();
+    auto clip = g.getClipBounds().toFloat();
+
+    auto first = juce::jlimit(0, numColumns - 1, (int)std::floor(clip.getX() - getColumnX(0)) - 1);
+    auto last = juce::jlimit(0, numColumns - 1, (int)std::ceil(clip.getRight() - getColumnX(0)) + 1);
+
+    if (last <= first)
+        return;
+
+    const auto& filled = traces.front();
+
+    if (filled.isActive)
+    {
+        // Fill FFT Background
+        fillPath.clear();
+        fillPath.startNewSubPath(getColumnX(first), bounds.getBottom());
+
+        for (int column = first; column <= last; ++column)
+            fillPath.lineTo(getColumnX(column), filled.levels[(size_t)column]);
+
+        fillPath.lineTo(getColumnX(last), bounds.getBottom());
+        fillPath.closeSubPath();
+
+        g.setFillType(juce::FillType(gradientImage, juce::AffineTransform::translation(bounds.getX(), bounds.getY())));
+        g.setOpacity(0.9f);
+        g.fillPath(fillPath);
+
+        // Fill FFT Outline
+        linePath.clear();
+        addCurve(linePath, filled.levels, first, last);
+
+        g.setColour(juce::Colours::darkgrey);
+        g.setOpacity(0.95f);
+        g.strokePath(linePath, juce::PathStrokeType(0.5f));
+
+        // Peak-Hold Line
+        linePath.clear();
+        addCurve(linePath, filled.peaks, first, last);
+
+        g.setColour(juce::Colours::lightgrey);
+        g.setOpacity(0.6f);
+        g.strokePath(linePath, juce::PathStrokeType(1.f));
+    }
+
+    for (size_t i = 1; i < traces.size(); ++i)
+    {
+        if (!traces[i].isActive)
+            continue;
+
+        linePath.clear();
+        addCurve(linePath, traces[i].levels, first, last);
+
+        g.setColour(i - 1 < lineColours.size() ? lineColours[i - 1] : juce::Colours::white);
+        g.setOpacity(0.9f);
+        g.strokePath(linePath, juce::PathStrokeType(1.5f));
+    }
+}
+
+/* Every trace active and moving everywhere each frame, so every update is a full repaint: the worst case */
+//==============================================================================
+double SpectrumRenderer::measurePaintTime(int width, int height, int numPoints, int numFrames)
+{
+    SpectrumRenderer renderer;
+    renderer.setBounds({ (float)width, (float)height });
+    renderer.setLineColours({ juce::Colours::red, juce::Colours::green, juce::Colours::blue });
+
+    SpectrumAnalyzer::Frame frame;
+    frame.traces.resize(4);
+
+    for (auto& trace : frame.traces)
+    {
+        trace.levels.assign((size_t)numPoints, 0.f);
+        trace.peaks.assign((size_t)numPoints, 0.f);
+        trace.isActive = true;
+    }
+
+    juce::Image image(juce::Image::ARGB, width, height, true);
+    juce::Graphics g(image);
+    juce::Random random(1);
+
+    double totalMs = 0;
+
+    for (int frameIndex = 0; frameIndex < numFrames; ++frameIndex)
+    {
+        for (size_t t = 0; t < frame.traces.size(); ++t)
+        {
+            auto& trace = frame.traces[t];
+
+            for (int i = 0; i < numPoints; ++i)
+            {
+                auto shape = 0.5f + 0.3f * std::sin(0.05f * (float)i + 0.3f * (float)frameIndex + (float)t);
+                auto level = juce::jlimit(0.f, 1.f, shape + 0.1f * random.nextFloat());
+
+                trace.levels[(size_t)i] = level;
+                trace.peaks[(size_t)i] = juce::jmax(level, trace.peaks[(size_t)i]);
+            }
+        }
+
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        renderer.invalidate();
+        renderer.update(frame);
+
+        g.fillAll(juce::Colours::black);
+        renderer.paint(g);
+
+        totalMs += juce::Time::getMillisecondCounterHiRes() - start;
+    }
+
+    return numFrames > 0 ? totalMs / numFrames : 0.0;
+}
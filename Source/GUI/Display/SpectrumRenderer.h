@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    SpectrumRenderer.h
+    Created: 17 Oct 2026 9:37:44pm
+    Author:  Joe Caulfield
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../DSP/SpectrumAnalyzer.h"
+
+/* Draws SpectrumAnalyzer frames: the first trace filled, with its peak-hold line, and any others
+   as coloured lines. Each frame is resampled to one point per pixel column through a table built
+   once per size, so the paths never hold more points than can be seen. The paths keep their storage
+   between frames, the fill gradient is rendered once per size into an image, and update() reports
+   only the area the curves swept since the last frame, so the caller can repaint just that */
+class SpectrumRenderer
+{
+public:
+    /* Message thread. The area to draw in, in the caller's coordinates */
+    void setBounds(juce::Rectangle<float> newBounds);
+
+    /* Colours of the line traces, in frame order after the first */
+    void setLineColours(std::vector<juce::Colour> newColours) { lineColours = std::move(newColours); }
+
+    /* Message thread. Takes a new frame, and returns the area that needs repainting */
+    juce::Rectangle<int> update(const SpectrumAnalyzer::Frame& frame);
+
+    /* Everything is redrawn on the next update() */
+    void invalidate() noexcept { needsFullRepaint = true; }
+
+    /* Only the columns inside the graphics context's clip are drawn */
+    void paint(juce::Graphics& g);
+
+    /* Mean milliseconds to update and paint one frame of numPoints, full area, into an offscreen image.
+       For profiling the renderer on its own; run by the spectrum benchmark in Benchmarks/ */
+    static double measurePaintTime(int width, int height, int numPoints, int numFrames);
+
+private:
+    struct Column
+    {
+        int firstPoint;     // First point to max-pool, or interpolate from
+        int numPoints;      // Points to max-pool. Zero to interpolate between firstPoint and the next
+        float fraction;     // Interpolation position
+    };
+
+    /* One y-coordinate per column */
+    struct TraceColumns
+    {
+        std::vector<float> levels, peaks;
+        bool isActive{ false };
+    };
+
+    void buildColumns(int numPoints);
+    void buildGradient();
+    float toY(float level) const noexcept { return bounds.getY() + (1.f - level) * bounds.getHeight() - 2.f; }
+    float getColumnX(int column) const noexcept { return bounds.getX() + 2.f + (float)column; }
+    void resample(const std::vector<float>& levels, std::vector<float>& ys) const noexcept;
+    void addCurve(juce::Path& path, const std::vector<float>& ys, int first, int last) const;
+
+    juce::Rectangle<float> bounds;
+    std::vector<Column> columns;
+    int numTablePoints{ 0 };
+    std::vector<TraceColumns> traces;
+    std::vector<float> scratch;                 // Next frame's column, before it is compared with the last
+
+    juce::Image gradientImage;
+    juce::Path fillPath, linePath;              // Cleared, not rebuilt, each paint
+    std::vector<juce::Colour> lineColours;
+
+    bool needsFullRepaint{ true };
+};
@@ -14,21 +14,18 @@
 WindowWrapperFrequency::WindowWrapperFrequency(TertiaryAudioProcessor& p,
     juce::AudioProcessorValueTreeState& apv)
     : audioProcessor(p),
-    apvts(apv),
-    forwardFFT(audioProcessor.fftOrder),
-    window(audioProcessor.fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris)
+    apvts(apv)
 {
     //if (setDebug)
     //    WLDebugger::getInstance().printMessage(mNameSpace, __func__, "");
 
     addAndMakeVisible(frequencyResponse);
 
-    // Array Maintenance ==========
-    fftDrawingPoints.ensureStorageAllocated(audioProcessor.scopeSize);
-    fftDrawingPoints.resize(audioProcessor.scopeSize);
-
-    for (int i = 0; i < audioProcessor.scopeSize; i++)
-        fftDrawingPoints.setUnchecked(i, 0);
+    // Band Spectra, in trace order after the mix
+    using namespace ColorScheme::BandColors;
+    spectrumRenderer.setLineColours({ makeOutlineColor(getLowBandBaseColor()),
+                                      makeOutlineColor(getMidBandBaseColor()),
+                                      makeOutlineColor(getHighBandBaseColor()) });
     
     startTimerHz(30);
 
@@ -46,6 +43,11 @@ WindowWrapperFrequency::~WindowWrapperFrequency()
 
     audioProcessor.apvts.removeParameterListener(params.at(Names::Show_FFT), this);
     audioProcessor.apvts.removeParameterListener(params.at(Names::FFT_Pickoff), this);
+    audioProcessor.apvts.removeParameterListener(params.at(Names::Show_Band_FFT), this);
+
+    /* Nothing left to draw for */
+    if (auto* analysis = audioProcessor.analysisHost.getState())
+        analysis->spectrumAnalyzer.setActiveTraces(0);
 }
 
 void WindowWrapperFrequency::resized()
@@ -63,21 +65,54 @@ void WindowWrapperFrequency::resized()
     spectrumArea.removeFromLeft(32);
     spectrumArea.removeFromRight(6);
 
+    spectrumRenderer.setBounds(spectrumArea);
+
     optionsMenu.setTopLeftPosition(1, 1);
 }
 
 void WindowWrapperFrequency::timerCallback()
 {
+    auto* analysis = audioProcessor.analysisHost.getState();
+
+    if (analysis == nullptr)
+        return;
+
+    auto& analyzer = analysis->spectrumAnalyzer;
+
+    /* Picked up here rather than from a parameter listener, which the host may call on the audio thread.
+       The worker only reconfigures when the settings actually change */
+    analyzer.setSettings(audioProcessor.getAnalyzerSettings());
+
+    /* The analysis worker only runs while there is a spectrum to draw, and only for the traces shown */
+    auto traces = getTracesToShow();
+    analyzer.setActiveTraces(traces);
+
+    if (traces != shownTraces)
+    {
+        shownTraces = traces;
+        spectrumRenderer.invalidate();
+        repaint();
+    }
+
     if (mShouldShowFFT)
     {
-        // Check for new FFT information
-        if (audioProcessor.nextFFTBlockReady)
+        // Check for new FFT information, and repaint only where the curves moved
+        if (analyzer.acquireLatestFrame())
+            repaint(spectrumRenderer.update(analyzer.getFrame()));
+
+        // Resolution & Analysis Cost, for the current FFT options
+        auto settings = analyzer.getSettings();
+
+        juce::String info;
+        info << settings.getFrameSize() << " pt  |  "
+             << juce::String(analyzer.getSampleRate() / settings.getFrameSize(), 1) << " Hz  |  "
+             << juce::String(analyzer.getCpuLoad() * 100.f, 1) << "% CPU";
+
+        if (info != analysisInfo)
         {
-            calculateNextFrameOfSpectrum();
-            audioProcessor.nextFFTBlockReady = false;
+            analysisInfo = info;
+            repaint(getAnalysisInfoArea());
         }
-
-        repaint(1, 1, getLocalBounds().getWidth() - 2, getLocalBounds().getHeight() - 2);
     }
 
 }
@@ -93,137 +128,46 @@ void WindowWrapperFrequency::paint(juce::Graphics& g)
     ///* Paint fft */
     // =========================
     if (mShouldShowFFT)
-        paintFFT(g, spectrumArea);
+        paintFFT(g);
 }
  
-void WindowWrapperFrequency::paintFFT(juce::Graphics& g, juce::Rectangle<float> bounds)
+void WindowWrapperFrequency::paintFFT(juce::Graphics& g)
 {
 
     //if (setDebug)
     //    WLDebugger::getInstance().printMessage(mNameSpace, __func__, "");
 
-    for (int i = 1; i < audioProcessor.scopeSize; ++i)
-    {
-        float startY = bounds.getY() + juce::jmap(audioProcessor.scopeData[i - 1],
-            0.0f,
-            1.0f,
-            bounds.getHeight(),
-            0.0f);
-
-        fftDrawingPoints.set(i - 1, startY);
-    }
-
-    juce::Path f;
-
-    f.startNewSubPath(bounds.getX() + 2, bounds.getBottom());
-
-    int curve = 3;
-
-    for (int i = 0; i < fftDrawingPoints.size() - curve - 1; i++)
-    {
-        if (i % curve == 0 && i > 0)
-        {
-            float x0 = juce::jmap((float)i - curve, 0.f,
-                (float)(fftDrawingPoints.size()) - 1.f,
-                2.f,
-                bounds.getWidth() - 2);
-
-            float x1 = juce::jmap((float)i,
-                0.f,
-                (float)(fftDrawingPoints.size()) - 1.f,
-                2.f,
-                bounds.getWidth() - 2);
-
-            float x2 = juce::jmap((float)i + curve,
-                0.f,
-                (float)(fftDrawingPoints.size()) - 1.f,
-                2.f,
-                bounds.getWidth() - 2);
-
-            juce::Point<float> point0 = { bounds.getX() + x0, fftDrawingPoints[i - curve] - 2 };
-            juce::Point<float> point1 = { bounds.getX() + x1, fftDrawingPoints[i] - 2 };
-            juce::Point<float> point2 = { bounds.getX() + x2, fftDrawingPoints[i + curve] - 2 };
-
-            float tempMax = juce::jmin(point0.getY(), point1.getY(), point2.getY());
-
-            f.cubicTo(point0, point1, point2);
-        }
-
-    }
-
-    f.lineTo(bounds.getRight(), bounds.getBottom());
-    f.closeSubPath();
-
-    // Fill FFT Background
-    float p1 = 0.25f;
-    float p2 = 0.5f;
-
-    auto gradient = juce::ColourGradient(juce::Colours::grey,
-        bounds.getBottomLeft(),
-        juce::Colours::lightgrey,
-        bounds.getTopRight(), false);
-
-    gradient.addColour(p1, juce::Colours::white.withBrightness(1.25f));
-    gradient.addColour(p2, juce::Colours::whitesmoke.withBrightness(1.25f));
+    /* Mix fill, outline and peak-hold, then the band spectra. Drawn from the last frame taken in timerCallback */
+    spectrumRenderer.paint(g);
 
-    g.setGradientFill(gradient);
-    g.setOpacity(0.9f);
-    g.fillPath(f);
-
-    // Fill FFT Outline
-    g.setColour(juce::Colours::darkgrey);
-    g.setOpacity(0.95f);
-    g.strokePath(f, juce::PathStrokeType(0.5f));
+    g.setFont(10.f);
+    g.setColour(juce::Colours::lightgrey);
+    g.drawFittedText(analysisInfo, getAnalysisInfoArea(), juce::Justification::centredRight, 1);
 
 }
 
-
-
-
-void WindowWrapperFrequency::calculateNextFrameOfSpectrum()
+/* The mix spectrum whenever the FFT is shown, plus each audible band's in Band FFT mode */
+// ========================================================
+SpectrumAnalyzer::TraceMask WindowWrapperFrequency::getTracesToShow() const
 {
-    // Apply Window Function to Data
-    window.multiplyWithWindowingTable(audioProcessor.fftData, audioProcessor.fftSize);
+    using Analyzer = SpectrumAnalyzer;
 
-    // Render FFT Data
-    forwardFFT.performFrequencyOnlyForwardTransform(audioProcessor.fftData);
+    if (!mShouldShowFFT)
+        return 0;
 
-    auto mindB = -60.f;
-    auto maxdB = 0.0f;
-
-    for (int i = 0; i < audioProcessor.scopeSize; ++i)
-    {
-        auto linearScale = i / float(audioProcessor.scopeSize) * 9.699f;
-        auto skewedProportionX = (20 * pow(2, linearScale)) / 20000;
-
-        //
-        auto fftDataIndex = juce::jlimit(0,                                                          // Lower
-            audioProcessor.fftSize / 2,                                      // Upper Limit
-            (int)(skewedProportionX * (float)audioProcessor.fftSize * 0.5f)  // Value to Constrain
-        );
-
-        // Clamps the value to within specified dB range
-        auto limit = juce::jlimit(mindB,      // Lower Limit
-            maxdB,      // Upper Limit
-            juce::Decibels::gainToDecibels(audioProcessor.fftData[fftDataIndex]) - juce::Decibels::gainToDecibels((float)audioProcessor.fftSize)  // Value to Constrain
-        );
-
-
-        auto level = juce::jmap(limit,  // Source Value
-            mindB,  // Source Range Min
-            maxdB,  // Source Range Max
-            0.0f,   // Target Range Min
-            1.0f    // Target Range Max
-        );
-
-        audioProcessor.scopeData[i] = level;                                   // [4]
-    }
+    auto traces = Analyzer::traceBit(TertiaryAudioProcessor::mixTrace);
 
+    if (mShouldShowBandFFT)
+        for (int band = 0; band < TertiaryAudioProcessor::numBands; ++band)
+            if (audioProcessor.isBandAudible(band))
+                traces |= Analyzer::traceBit(TertiaryAudioProcessor::bandTrace(band));
 
+    return traces;
 }
 
 
 
+
 void WindowWrapperFrequency::parameterChanged(const juce::String& parameterID, float newValue)
 {
     DBG("PARAMETER CHANGED WWF");
@@ -250,8 +194,44 @@ void WindowWrapperFrequency::buildOptionsMenuParameters()
                                     audioProcessor.apvts,
                                     params.at(Names::FFT_Pickoff));
 
+    optionsMenu.addOptionToList(    "Band FFT",
+                                    "Overlay Each Band's Spectrum",
+                                    audioProcessor.apvts,
+                                    params.at(Names::Show_Band_FFT));
+
+    optionsMenu.addOptionToList(    "Linear Phase",
+                                    "Linear Phase Crossover",
+                                    audioProcessor.apvts,
+                                    params.at(Names::Crossover_Mode));
+
+    optionsMenu.addChoiceToList(    "FFT Size",
+                                    "Larger sizes resolve low frequencies better, at more CPU",
+                                    audioProcessor.apvts,
+                                    params.at(Names::FFT_Size));
+
+    optionsMenu.addChoiceToList(    "FFT Window",
+                                    "Trades frequency resolution against leakage",
+                                    audioProcessor.apvts,
+                                    params.at(Names::FFT_Window));
+
+    optionsMenu.addChoiceToList(    "FFT Overlap",
+                                    "More overlap updates faster, at more CPU",
+                                    audioProcessor.apvts,
+                                    params.at(Names::FFT_Overlap));
+
+    optionsMenu.addChoiceToList(    "FFT Zero Padding",
+                                    "Smoother low-frequency curves, at more CPU",
+                                    audioProcessor.apvts,
+                                    params.at(Names::FFT_Zero_Padding));
+
+    optionsMenu.addChoiceToList(    "Sub-Block Size",
+                                    "Smaller blocks follow parameter changes more closely",
+                                    audioProcessor.apvts,
+                                    params.at(Names::Sub_Block_Size));
+
     audioProcessor.apvts.addParameterListener(params.at(Names::Show_FFT), this);
     audioProcessor.apvts.addParameterListener(params.at(Names::FFT_Pickoff), this);
+    audioProcessor.apvts.addParameterListener(params.at(Names::Show_Band_FFT), this);
 
     optionsMenu.setName("FREQ OPTIONS");
 
@@ -270,6 +250,7 @@ void WindowWrapperFrequency::updateOptionsParameters()
     //    WLDebugger::getInstance().printMessage(mNameSpace, __func__, "");
 
     mShouldShowFFT = audioProcessor.getShowFftParam()->get();
+    mShouldShowBandFFT = audioProcessor.getShowBandFftParam()->get();
 
     auto mPickoffID = audioProcessor.getFftPickofIdParam()->getIndex();
     audioProcessor.setFftPickoffPoint(mPickoffID);
@@ -13,6 +13,7 @@
 #include <JuceHeader.h>
 #include "FrequencyResponse.h"
 #include "OptionsMenu.h"
+#include "SpectrumRenderer.h"
 
 struct WindowWrapperFrequency : juce::Component, 
                                 juce::Timer,
@@ -27,7 +28,7 @@ struct WindowWrapperFrequency : juce::Component,
     void timerCallback();
     
     void paint(juce::Graphics& g);
-    void paintFFT(juce::Graphics& g, juce::Rectangle<float> bounds);
+    void paintFFT(juce::Graphics& g);
 
     FrequencyResponse& getFrequencyResponse() { return frequencyResponse; };
 
@@ -53,15 +54,19 @@ private:
     std::unique_ptr<buttonAttachment>	showFftAttachment;
 
     bool mShouldShowFFT{ false };
+    bool mShouldShowBandFFT{ false };
+
+    SpectrumAnalyzer::TraceMask getTracesToShow() const;
+    SpectrumAnalyzer::TraceMask shownTraces{ 0 };      // As of the last timer tick
+
+    /* Frame size, resolution and analysis CPU for the current FFT options, top-right of the spectrum */
+    juce::String analysisInfo;
+    juce::Rectangle<int> getAnalysisInfoArea() const { return spectrumArea.toNearestInt().removeFromTop(14).reduced(4, 0); }
 
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
     // FFT Components =========
-    void calculateNextFrameOfSpectrum();
-    
-    juce::Array<float> fftDrawingPoints;
-    juce::dsp::FFT forwardFFT;
-    juce::dsp::WindowingFunction<float> window;
+    SpectrumRenderer spectrumRenderer;
     float fftConstant{ 9.9658f };
 
     juce::Rectangle<float> spectrumArea;
@@ -45,6 +45,9 @@ private:
     /* Reference to the Audio Processor & DSP Parameters */
     TertiaryAudioProcessor& audioProcessor;
 
+    /* Keeps the meters and analyzer allocated while the editor is open. Declared first, so it outlives every display */
+    AnalysisHost::Consumer analysisConsumer{ audioProcessor.analysisHost };
+
     /* Time-Domain Display */
     WindowWrapperOscilloscope wrapperOscilloscope{ audioProcessor };
 
@@ -18,11 +18,6 @@ TertiaryAudioProcessor::TertiaryAudioProcessor()
     attachParametersToLayout();
     addParameterListeners();
     
-	/* Initialize the LFO */
-	lowLFO.initializeLFO(getSampleRate());
-	midLFO.initializeLFO(getSampleRate());
-	highLFO.initializeLFO(getSampleRate());
-
     lowLFO.setLfoID(0);
     midLFO.setLfoID(1);
     highLFO.setLfoID(2);
@@ -31,12 +26,13 @@ TertiaryAudioProcessor::TertiaryAudioProcessor()
     midLFO.setDsp(true);
     highLFO.setDsp(true);
     
-    // Set Crossover Types
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
+    // Build the crossover tree, one band per tremolo
+    getChain<float>().crossover.setNumBands(numBands);
+    getChain<double>().crossover.setNumBands(numBands);
+    linearPhaseCrossover.setNumBands(numBands);
+
+    // A newly attached analyzer starts with the current FFT options
+    analysisHost.onCreate = [this](AnalysisState& state) { state.spectrumAnalyzer.setSettings(getAnalyzerSettings()); };
 }
 
 //==============================================================================
@@ -80,6 +76,7 @@ void TertiaryAudioProcessor::attachParametersToLayout()
     /* Initialize Crossover Frequencies */
     floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
     floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    choiceHelper(crossoverModeParam, Names::Crossover_Mode);
 
     /* Initialize Low Band Parameters */
     boolHelper(lowBandTrem.bypassParam, Names::Bypass_Low_Band);
@@ -135,60 +132,36 @@ void TertiaryAudioProcessor::attachParametersToLayout()
 
     boolHelper(showFftParam, Names::Show_FFT);
     choiceHelper(fftPickoffParam, Names::FFT_Pickoff);
+    boolHelper(showBandFftParam, Names::Show_Band_FFT);
+    choiceHelper(fftSizeParam, Names::FFT_Size);
+    choiceHelper(fftWindowParam, Names::FFT_Window);
+    choiceHelper(fftOverlapParam, Names::FFT_Overlap);
+    choiceHelper(fftZeroPaddingParam, Names::FFT_Zero_Padding);
+
+    choiceHelper(subBlockSizeParam, Names::Sub_Block_Size);
 
 }
 
-/* Registers AudioProcessor as a listener to all parameters */
+/* Registers the LFO parameters with the dispatcher. Every other parameter is read once per block in updateState() */
 //==============================================================================
 void TertiaryAudioProcessor::addParameterListeners()
 {
-    /* Local reference to parameter mapping */
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    apvts.addParameterListener(params.at(Names::Input_Gain), this);
-    apvts.addParameterListener(params.at(Names::Output_Gain), this);
-    apvts.addParameterListener(params.at(Names::Low_Mid_Crossover_Freq), this);
-    apvts.addParameterListener(params.at(Names::Mid_High_Crossover_Freq), this);
-    apvts.addParameterListener(params.at(Names::Bypass_Low_Band), this);
-    apvts.addParameterListener(params.at(Names::Bypass_Mid_Band), this);
-    apvts.addParameterListener(params.at(Names::Bypass_High_Band), this);
-    apvts.addParameterListener(params.at(Names::Mute_Low_Band), this);
-    apvts.addParameterListener(params.at(Names::Mute_Mid_Band), this);
-    apvts.addParameterListener(params.at(Names::Mute_High_Band), this);
-    apvts.addParameterListener(params.at(Names::Solo_Low_Band), this);
-    apvts.addParameterListener(params.at(Names::Solo_Mid_Band), this);
-    apvts.addParameterListener(params.at(Names::Solo_High_Band), this);
-    apvts.addParameterListener(params.at(Names::Gain_Low_Band), this);
-    apvts.addParameterListener(params.at(Names::Gain_Mid_Band), this);
-    apvts.addParameterListener(params.at(Names::Gain_High_Band), this);
-    apvts.addParameterListener(params.at(Names::Wave_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Depth_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Symmetry_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Invert_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Sync_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Rate_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Multiplier_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Relative_Phase_Low_LFO), this);
-    apvts.addParameterListener(params.at(Names::Wave_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Depth_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Symmetry_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Invert_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Sync_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Rate_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Multiplier_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Relative_Phase_Mid_LFO), this);
-    apvts.addParameterListener(params.at(Names::Wave_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Depth_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Symmetry_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Invert_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Sync_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Rate_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Multiplier_High_LFO), this);
-    apvts.addParameterListener(params.at(Names::Relative_Phase_High_LFO), this);
-
-    //apvts.addParameterListener(params.at(Names::Scope_Point1), this);
-    //apvts.addParameterListener(params.at(Names::Scope_Point2), this);
+    const std::array<LFO*, numBands> lfos { &lowLFO, &midLFO, &highLFO };
+
+    for (int band = 0; band < (int)lfos.size(); ++band)
+    {
+        auto& lfo = *lfos[(size_t)band];
+
+        parameterDispatcher.add(lfo.waveshapeParam, lfoShapeChanged(band));
+        parameterDispatcher.add(lfo.depthParam, lfoShapeChanged(band));
+        parameterDispatcher.add(lfo.symmetryParam, lfoShapeChanged(band));
+        parameterDispatcher.add(lfo.invertParam, lfoShapeChanged(band));
+
+        parameterDispatcher.add(lfo.rateParam, lfoTimingChanged(band));
+        parameterDispatcher.add(lfo.multiplierParam, lfoTimingChanged(band));
+        parameterDispatcher.add(lfo.relativePhaseParam, lfoTimingChanged(band));
+        parameterDispatcher.add(lfo.syncToHostParam, lfoTimingChanged(band));
+    }
 }
 
 /* Recalls previously saved settings */
@@ -259,6 +232,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout TertiaryAudioProcessor::crea
                                                         NormalisableRange<float> (20, 20000, 1, 0.5f),                // Range
                                                         1000));                                                     // Default Value
 
+    sa = { "Linkwitz-Riley", "Linear Phase" };
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::Crossover_Mode),1},    // Parameter ID
+                                                        params.at(Names::Crossover_Mode),                   // Parameter Name
+                                                        sa,                                                 // Choices
+                                                        0));                                                // Default Value
+
     /* LFO Waveshape */
     // ===================================================================================================================
     sa = {  "Ramp Down",
@@ -541,6 +521,53 @@ juce::AudioProcessorValueTreeState::ParameterLayout TertiaryAudioProcessor::crea
                                                         sa,
                                                         0));
 
+    layout.add(std::make_unique<AudioParameterBool>(    ParameterID{params.at(Names::Show_Band_FFT), 1},    // Parameter ID & Hint
+                                                        params.at(Names::Show_Band_FFT),                    // Parameter Name
+                                                        false));                                            // Default Value
+
+    sa.clear();
+    sa = { "1024 pt", "2048 pt", "4096 pt", "8192 pt", "16384 pt", "32768 pt" };     // FFT order 10 to 15
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::FFT_Size), 1},     // Parameter ID & Hint
+                                                        params.at(Names::FFT_Size),                     // Parameter Name
+                                                        sa,
+                                                        2));
+
+    sa.clear();
+    sa = { "Hann", "Blackman-Harris", "Flat Top", "Rectangular" };
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::FFT_Window), 1},   // Parameter ID & Hint
+                                                        params.at(Names::FFT_Window),                   // Parameter Name
+                                                        sa,
+                                                        1));
+
+    sa.clear();
+    sa = { "No Overlap", "50% Overlap", "75% Overlap", "87.5% Overlap" };
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::FFT_Overlap), 1},  // Parameter ID & Hint
+                                                        params.at(Names::FFT_Overlap),                  // Parameter Name
+                                                        sa,
+                                                        1));
+
+    sa.clear();
+    sa = { "No Padding", "2x Padding", "4x Padding" };
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::FFT_Zero_Padding), 1},     // Parameter ID & Hint
+                                                        params.at(Names::FFT_Zero_Padding),                     // Parameter Name
+                                                        sa,
+                                                        0));
+
+    /* Engine */
+    // ===================================================================================================================
+    sa.clear();
+    sa = { "16 Samples", "32 Samples", "64 Samples", "128 Samples", "256 Samples" };    // minSubBlockSize << index
+
+    layout.add(std::make_unique<AudioParameterChoice>(  ParameterID{params.at(Names::Sub_Block_Size), 1},       // Parameter ID & Hint
+                                                        params.at(Names::Sub_Block_Size),                       // Parameter Name
+                                                        sa,
+                                                        2,
+                                                        AudioParameterChoiceAttributes().withAutomatable(false)));
+
     return layout;
 }
 
@@ -550,37 +577,81 @@ void TertiaryAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
 {
     /* Prepare DSP ProcessSpec */
     juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
+    spec.maximumBlockSize = (juce::uint32)maxSubBlockSize;     // The largest Sub-Block Size choice, so switching between them never needs a re-prepare
     spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
 
-    /* Pass spec information into Input & Output Gain */
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
-
-    /* Pass spec information into filters */
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-    AP2.prepare(spec);
-    LP2.prepare(spec);
-    HP2.prepare(spec);
+    /* Reset the LFO glides and land on the current shape, before any audio is processed.
+       Anything flagged before this point is already covered by updateLFO() */
+    parameterDispatcher.consume();
 
-    /* Set size for filter buffers prior to audio processing */
-    for (auto& buffer : filterBuffers)
+    for (auto* lfo : { &lowLFO, &midLFO, &highLFO })
     {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
+        lfo->initializeLFO(sampleRate);
+        lfo->updateLFO(sampleRate, hostInfo.bpm);
     }
 
+    /* Only the chain for the host's processing precision is prepared */
+    if (isUsingDoublePrecision())
+        prepareChain(getChain<double>(), spec);
+    else
+        prepareChain(getChain<float>(), spec);
+
+    /* Linear-phase engine, which also sizes its band buffers */
+    linearPhaseCrossover.setCrossoverFrequency(0, lowMidCrossover->get());
+    linearPhaseCrossover.setCrossoverFrequency(1, midHighCrossover->get());
+    linearPhaseCrossover.prepare(spec);
+
+    linearPhaseActive = crossoverModeParam->getIndex() == 1;
+    setEngineLatency(linearPhaseActive ? linearPhaseCrossover.getLatencyInSamples() : 0);
+
+    /* Crossfade into and out of the passthrough state */
+    passthroughMix.reset(sampleRate, 0.02);
+    passthroughTarget = isTransparent();
+    passthroughMix.setCurrentAndTargetValue(passthroughTarget ? 1.f : 0.f);
+    passthroughSettleSamples = 0;
+
     /* Used to reduce audio artifacts by smoothing the gain changes */
-    inputGain.setRampDurationSeconds(0.05);
-    outputGain.setRampDurationSeconds(0.05);
+    outputGain.reset(sampleRate, 0.05);
+    outputGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(outputGainParam->get()));
+
+    for (auto& trem : tremolos)
+        trem.prepare(sampleRate);
     
-    /* RMS Level Smoothing for Meters */
-    rmsLevelInputLeft.reset(sampleRate, 0.5);   rmsLevelInputLeft.setCurrentAndTargetValue(-100.f);
-    rmsLevelInputRight.reset(sampleRate, 0.5);  rmsLevelInputRight.setCurrentAndTargetValue(-100.f);
-    rmsLevelOutputLeft.reset(sampleRate, 0.5);  rmsLevelOutputLeft.setCurrentAndTargetValue(-100.f);
-    rmsLevelOutputRight.reset(sampleRate, 0.5); rmsLevelOutputRight.setCurrentAndTargetValue(-100.f);
+    /* Input & Output Meters and Frequency Analyzer, now if attached, otherwise whenever they are */
+    analysisHost.prepare(sampleRate, (int)spec.numChannels, maxSubBlockSize);
+
+}
+
+/* Sizes and prepares the sample-type dependent half of the signal chain */
+//==============================================================================
+template <typename SampleType>
+void TertiaryAudioProcessor::prepareChain(SignalChain<SampleType>& chain, const juce::dsp::ProcessSpec& spec)
+{
+    /* Pass spec information into Input Gain. Preparing snaps it to the current setting */
+    chain.inputGain.setGainDecibels(inputGainParam->get());
+    chain.inputGain.prepare(spec);
+    chain.inputGain.setRampDurationSeconds(0.05);     // Used to reduce audio artifacts by smoothing the gain changes
+
+    /* Pass spec information into the crossover, which also sizes its band buffers */
+    chain.crossover.setCrossoverFrequency(0, lowMidCrossover->get());
+    chain.crossover.setCrossoverFrequency(1, midHighCrossover->get());
+    chain.crossover.prepare(spec);
+
+    /* One combined gain curve per band, plus the output gain curve */
+    chain.gainCurves.setSize(numBands + 1, (int)spec.maximumBlockSize);
+
+    /* Dry copy of the input, for crossfading into and out of the passthrough state */
+    chain.passthroughBuffer.setSize((int)spec.numChannels, (int)spec.maximumBlockSize);
+}
 
+/* Clears the filter history of every crossover engine */
+//==============================================================================
+void TertiaryAudioProcessor::resetCrossovers()
+{
+    getChain<float>().crossover.reset();
+    getChain<double>().crossover.reset();
+    linearPhaseCrossover.reset();
 }
 
 /* Called upon any change in multiplier value.  Forces all LFO read-back positions to
@@ -592,25 +663,59 @@ void TertiaryAudioProcessor::forceSynchronization(LFO& lfo)
     if (/*hostInfo.isPlaying && */ lfo.isSyncedToHost())
     {
         /* When host BPM present, force LFO position to sync to host */
-        float div = 1.f;
-        div = 1.f / lfo.getWaveMultiplier();
-        float playPositionScaled = fmod(playPosition, div);
-        float newPhase = playPositionScaled * lfo.getWaveMultiplier() * lfo.getWaveTableSize();
-        lfo.setPosition( fmod(newPhase, lfo.getWaveTableSize()) );
+        double div = 1.0;
+        div = 1.0 / lfo.getWaveMultiplier();
+        double playPositionScaled = fmod(playPosition, div);
+        lfo.setPhase( playPositionScaled * lfo.getWaveMultiplier() );
     }
     else if (!hostInfo.isPlaying && lfo.isSyncedToHost())
     {
         /* When no host BPM, force LFO position to sync to each other */
         if (lowLFO.isSyncedToHost())
-            lfo.setPosition( lowLFO.getPosition() );
+            lfo.setPhase( lowLFO.getPhase() );
         else if (midLFO.isSyncedToHost())
-            lfo.setPosition( midLFO.getPosition() );
+            lfo.setPhase( midLFO.getPhase() );
         else if (highLFO.isSyncedToHost())
-            lfo.setPosition( highLFO.getPosition() );
+            lfo.setPhase( highLFO.getPhase() );
     }
 
 }
 
+/* Switches between the Linkwitz-Riley and linear-phase engines, and reports the new latency to the host */
+//==============================================================================
+void TertiaryAudioProcessor::setCrossoverMode(bool useLinearPhase)
+{
+    if (useLinearPhase == linearPhaseActive)
+        return;
+
+    linearPhaseActive = useLinearPhase;
+
+    /* Clear the history of the engine coming in, so stale state isn't heard. The splitters weren't run while
+       linear phase was on, so their glides land straight on the current crossovers instead of sweeping from old ones */
+    if (linearPhaseActive)
+        linearPhaseCrossover.reset();
+    else
+    {
+        getChain<float>().crossover.snapToTargets();
+        getChain<double>().crossover.snapToTargets();
+        getChain<float>().crossover.reset();
+        getChain<double>().crossover.reset();
+    }
+
+    setEngineLatency(linearPhaseActive ? linearPhaseCrossover.getLatencyInSamples() : 0);
+}
+
+/* Reports the latency to the host, and has the LFOs read that far behind. Their gain curves are applied
+   after the crossover, so without this they would land the latency ahead of the audio once the host compensates */
+//==============================================================================
+void TertiaryAudioProcessor::setEngineLatency(int numSamples)
+{
+    setLatencySamples(numSamples);
+
+    for (auto* lfo : { &lowLFO, &midLFO, &highLFO })
+        lfo->setLatencyCompensation(numSamples);
+}
+
 //==============================================================================
 void TertiaryAudioProcessor::setFftPickoffPoint(int point)
 {
@@ -624,49 +729,38 @@ void TertiaryAudioProcessor::setFftPickoffPoint(int point)
     }
 }
 
-/* Returns value of RMS level to the Input Meters upon request */
+/* Each choice index maps straight onto the analyzer's orders; the windows follow the param's choice list */
 //==============================================================================
-float TertiaryAudioProcessor::getRmsValue(const int pickOffPoint, const int channel) const {
-    jassert(channel == 0 || channel == 1);
+SpectrumAnalyzer::Settings TertiaryAudioProcessor::getAnalyzerSettings() const
+{
+    using Window = SpectrumAnalyzer::Settings::Window;
+    static constexpr std::array<Window, 4> windows { Window::hann, Window::blackmanHarris, Window::flatTop, Window::rectangular };
 
-    if (pickOffPoint == 0)
-    {
-        if (channel == 0)
-            return rmsLevelInputLeft.getCurrentValue();
-        if (channel == 1)
-            return rmsLevelInputRight.getCurrentValue();
-        return 0;
-    }
+    SpectrumAnalyzer::Settings settings;
+    settings.fftOrder = SpectrumAnalyzer::minFftOrder + fftSizeParam->getIndex();
+    settings.window = windows[(size_t)juce::jlimit(0, (int)windows.size() - 1, fftWindowParam->getIndex())];
+    settings.overlapOrder = fftOverlapParam->getIndex();
+    settings.paddingOrder = fftZeroPaddingParam->getIndex();
 
-    if (pickOffPoint == 1)
-    {
-        if (channel == 0)
-            return rmsLevelOutputLeft.getCurrentValue();
-        if (channel == 1)
-            return rmsLevelOutputRight.getCurrentValue();
-        return 0;
-    }
+    return settings;
 }
 
+/* Returns the latest meter levels to the Input and Output Meters upon request */
 //==============================================================================
-void TertiaryAudioProcessor::pushNextSampleIntoFifo(float sample)
+LevelMeter::Snapshot TertiaryAudioProcessor::getMeterSnapshot(const int pickOffPoint) const
 {
-    /* If the fifo contains enough data, set a flag
-    * to say that the next frame should now be rendered */
+    jassert(pickOffPoint == 0 || pickOffPoint == 1);
 
-    if (fifoIndex == fftSize)
-    {
-        if (!nextFFTBlockReady)
-        {
-            juce::zeromem(fftData, sizeof(fftData));
-            memcpy(fftData, fifo, sizeof(fifo));
-            nextFFTBlockReady = true;
-        }
+    if (auto* state = analysisHost.getState())
+        return pickOffPoint == 0 ? state->inputMeter.getSnapshot() : state->outputMeter.getSnapshot();
 
-        fifoIndex = 0;
-    }
+    LevelMeter::Snapshot silence;
+    silence.peak.fill(LevelMeter::floorDecibels);
+    silence.rms.fill(LevelMeter::floorDecibels);
+    silence.truePeak.fill(LevelMeter::floorDecibels);
+    silence.momentaryLoudness = silence.shortTermLoudness = LevelMeter::floorDecibels;
 
-    fifo[fifoIndex++] = sample;
+    return silence;
 }
 
 
@@ -674,14 +768,27 @@ void TertiaryAudioProcessor::pushNextSampleIntoFifo(float sample)
 
 
 
+
 /* ============================================================================================================== */
 /* MAIN DSP ===================================================================================================== */
 /* \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/   \/  \/  \/  \/  \/  \/  \/  \/  \/  */
 
 
-/* Main Audio Signal Processing Callback */
+/* Main Audio Signal Processing Callbacks. Both precisions run the same templated chain */
+//==============================================================================
+void TertiaryAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    processBlockInternal(buffer);
+}
+
+void TertiaryAudioProcessor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    processBlockInternal(buffer);
+}
+
 //==============================================================================
-void TertiaryAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+template <typename SampleType>
+void TertiaryAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer)
 {
     /* Housekeeping */
     juce::ScopedNoDenormals noDenormals;
@@ -699,83 +806,334 @@ void TertiaryAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
+    /* Meters and analyzer for this block, if anything is attached to look at them */
+    const AnalysisHost::ScopedAudioAccess analysisAccess(analysisHost, analysis);
+
+    /* Run the engine on sub-blocks, so parameters are picked up at most subBlockSize samples late.
+       The host delivers automation already flattened to the block, so a fixed grid is the finest split available */
+    auto numSamples = buffer.getNumSamples();
+    auto subBlockSize = getSubBlockSize();
+
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        // Refers to the host buffer; nothing is copied or allocated
+        juce::AudioBuffer<SampleType> subBlock(buffer.getArrayOfWritePointers(),
+                                               buffer.getNumChannels(),
+                                               start,
+                                               juce::jmin(subBlockSize, numSamples - start));
+
+        processSubBlock(subBlock);
+    }
+}
+
+/* Runs the full signal chain on one sub-block, with the parameters current at its start */
+//==============================================================================
+template <typename SampleType>
+void TertiaryAudioProcessor::processSubBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto& chain = getChain<SampleType>();
+
     /* Update Processing State */
     updateState();
 
+    /* Once the input is silent and the tails have rung out, skip the chain entirely */
+    if (updateIdleState(buffer))
+    {
+        processIdle(buffer);
+        return;
+    }
+
+    /* With every band bypassed and every gain at unity, the chain is only the crossover's allpass, so run that alone.
+       Whichever path sat idle first runs alongside the other until its stale state has rung out, then they crossfade.
+       The passthrough never goes through the input gain, so it waits for that to finish ramping; otherwise the ramp
+       would sit frozen part-way and step the level on the way back */
+    auto transparent = isTransparent() && !chain.inputGain.isSmoothing();
+
+    if (transparent != passthroughTarget)
+    {
+        passthroughTarget = !passthroughTarget;
+
+        // Mid-settle or mid-fade, both paths are already running
+        auto bothRunning = passthroughSettleSamples > 0 || passthroughMix.isSmoothing();
+        passthroughSettleSamples = bothRunning ? 0 : chain.crossover.getSettlingSamples();
+    }
+
+    if (passthroughSettleSamples <= 0)
+        passthroughMix.setTargetValue(passthroughTarget ? 1.f : 0.f);
+
+    auto isFading = passthroughSettleSamples > 0 || passthroughMix.isSmoothing();
+    passthroughSettleSamples = juce::jmax(0, passthroughSettleSamples - buffer.getNumSamples());
+
+    if (!isFading && passthroughMix.getCurrentValue() == 1.f)
+    {
+        processPassthrough(buffer);
+        return;
+    }
+
+    // Refers to the dry copy, trimmed to this sub-block
+    juce::AudioBuffer<SampleType> dry(chain.passthroughBuffer.getArrayOfWritePointers(), buffer.getNumChannels(), buffer.getNumSamples());
+
+    if (isFading)
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            dry.copyFrom(channel, 0, buffer, channel, 0, buffer.getNumSamples());
+
     /* Apply Input Gain */
-    applyGain(buffer, inputGain);
+    applyGain(buffer, chain.inputGain);
 
     /* If Pickoff Point is Input, Update FFT */
     if (fftPickoffPointIsInput) { pushSignalToFFT(buffer); }
     
     /* Get Levels for Input Meters */
-    updateMeterLevels(rmsLevelInputLeft, rmsLevelInputRight, buffer);
+    if (analysis != nullptr)
+        analysis->inputMeter.process(buffer);
 
-    /* Apply Crossover */
-    applyCrossover(buffer);
+    /* Apply Crossover. While fading, the dry copy goes through the same allpass the bands sum to */
+    if (linearPhaseActive)
+    {
+        linearPhaseCrossover.process(buffer);
 
-    /* Apply Amplitude Modulation */
-    applyAmplitudeModulation();
-    
-    /* Apply Individual Band Gains on Lows, Mids, Highs */
-    for (size_t i = 0; i < filterBuffers.size(); ++i) { applyGain(filterBuffers[i], tremolos[i].bandGain); }
+        if (isFading)
+            chain.crossover.processAllpass(dry);
+    }
+    else
+    {
+        chain.crossover.process(buffer, isFading ? &dry : nullptr);
+    }
 
-    /* Check for Bypass, Solo, Mute and Re-sum the Individual Bands */
-    sumAudioBands(buffer);
-    
-    /* Apply Output Gain */
-    applyGain(buffer, outputGain);
+    /* Apply Amplitude Modulation, Band Gains, Solo/Mute and Output Gain, and Re-sum the Bands */
+    applyOutputStage(buffer);
+
+    /* Blend with the allpassed input while entering or leaving the passthrough state */
+    if (isFading)
+        applyPassthroughCrossfade(buffer, dry);
 
     /* If Pickoff Point is Output, Update FFT */
     if (!fftPickoffPointIsInput) {  pushSignalToFFT(buffer); }
 
     /* Get Levels for Output Meters */
-    updateMeterLevels(rmsLevelOutputLeft, rmsLevelOutputRight, buffer);
+    if (analysis != nullptr)
+        analysis->outputMeter.process(buffer);
 
 }
 
-/* Housekeeping DURING audio processing */
+/* Tracks how long the input has been silent. Returns true once the filter tails have decayed */
 //==============================================================================
-void TertiaryAudioProcessor::updateState()
+template <typename SampleType>
+bool TertiaryAudioProcessor::updateIdleState(const juce::AudioBuffer<SampleType>& buffer)
 {
-    auto sampleRate = getSampleRate();
+    auto numSamples = buffer.getNumSamples();
 
-    /* Update Input & Output gain params*/
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
+    if (buffer.getMagnitude(0, numSamples) > (SampleType)silenceThreshold)
+    {
+        silentSamples = 0;
+        isIdle = false;
+        return false;
+    }
+
+    if (!isIdle)
+    {
+        silentSamples += numSamples;
+
+        if (silentSamples >= (int)std::ceil(getTailLengthSeconds() * getSampleRate()))
+        {
+            // Whatever is left in the filters is below the threshold; start clean when signal returns
+            isIdle = true;
+            resetCrossovers();
+        }
+    }
+
+    return isIdle;
+}
+
+/* Idle state: output silence, but keep the LFOs, smoothers and meters moving so nothing jumps on wake-up */
+//==============================================================================
+template <typename SampleType>
+void TertiaryAudioProcessor::processIdle(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto numSamples = buffer.getNumSamples();
+
+    buffer.clear();
+
+    // The input is silent, so the input gain lands on its target rather than resuming a ramp part-way on wake-up
+    getChain<SampleType>().inputGain.reset();
+
+    lowLFO.advance(numSamples);
+    midLFO.advance(numSamples);
+    highLFO.advance(numSamples);
+
+    outputGain.skip(numSamples);
 
-    /* Update tremolo effect params */
     for (auto& trem : tremolos)
-        trem.updateTremoloSettings();
+        trem.bandGain.skip(numSamples);
 
-    // Flag to update Low LFO parameters
-    if (parameterChangedLfoLow)
+    if (analysis != nullptr)
     {
-        lowLFO.updateLFO(sampleRate, hostInfo.bpm);
-        parameterChangedLfoLow = false;
+        analysis->inputMeter.decay(numSamples);
+        analysis->outputMeter.decay(numSamples);
     }
 
-    // Flag to update Mid LFO parameters
-    if (parameterChangedLfoMid)
+    /* Every trace is fed the silence, so the spectra fall away rather than freeze on their last frame */
+    pushSignalToFFT(buffer);
+
+    for (int band = 0; band < numBands; ++band)
+        if (isBandAnalysed(band))
+            analysis->getBandFeed(band).push(buffer);
+}
+
+/* True when the chain would leave the signal unchanged apart from the crossover's allpass.
+   Linear phase is excluded, since passing through would drop its reported latency */
+//==============================================================================
+bool TertiaryAudioProcessor::isTransparent() const
+{
+    if (linearPhaseActive || inputGainParam->get() != 0.f || outputGainParam->get() != 0.f)
+        return false;
+
+    for (auto& trem : tremolos)
+        if (!trem.bypassParam->get() || trem.muteParam->get() || trem.soloParam->get() || trem.bandGainParam->get() != 0.f)
+            return false;
+
+    return true;
+}
+
+/* If any bands are solo'ed, only those are heard. Otherwise everything except those which are muted */
+//==============================================================================
+bool TertiaryAudioProcessor::isBandAudible(int band) const
+{
+    auto bandsAreSoloed = false;
+    for (auto& trem : tremolos)
+        bandsAreSoloed = bandsAreSoloed || trem.soloParam->get();
+
+    auto& trem = tremolos[(size_t)band];
+
+    return bandsAreSoloed ? trem.soloParam->get() : !trem.muteParam->get();
+}
+
+/* True while the band's spectrum is shown. Only valid on the audio thread, within the block's analysis access */
+//==============================================================================
+bool TertiaryAudioProcessor::isBandAnalysed(int band) const
+{
+    return analysis != nullptr && analysis->spectrumAnalyzer.isTraceActive(bandTrace(band));
+}
+
+/* Passthrough state: only the crossover's allpass, so the output sounds just as the transparent chain would.
+   The LFOs, smoothers, FFT and meters keep moving */
+//==============================================================================
+template <typename SampleType>
+void TertiaryAudioProcessor::processPassthrough(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto numSamples = buffer.getNumSamples();
+
+    lowLFO.advance(numSamples);
+    midLFO.advance(numSamples);
+    highLFO.advance(numSamples);
+
+    outputGain.skip(numSamples);
+
+    for (auto& trem : tremolos)
+        trem.bandGain.skip(numSamples);
+
+    if (fftPickoffPointIsInput) { pushSignalToFFT(buffer); }
+
+    if (analysis != nullptr)
+        analysis->inputMeter.process(buffer);
+
+    /* Every band is at unity here, so each band as heard is just the crossover's band. While any band trace is shown,
+       the tree runs alongside the allpass path to keep it fed; the output still comes from the allpass path alone */
+    auto& crossover = getChain<SampleType>().crossover;
+    auto bandsAreAnalysed = false;
+
+    for (int band = 0; band < numBands; ++band)
+        bandsAreAnalysed = bandsAreAnalysed || isBandAnalysed(band);
+
+    if (bandsAreAnalysed)
     {
-        midLFO.updateLFO(sampleRate, hostInfo.bpm);
-        parameterChangedLfoMid = false;
+        crossover.process(buffer, &buffer);
+
+        for (int band = 0; band < numBands; ++band)
+            if (isBandAnalysed(band))
+                analysis->getBandFeed(band).push(crossover.getBand(band));
     }
+    else
+    {
+        crossover.processAllpass(buffer);
+    }
+
+    if (!fftPickoffPointIsInput) { pushSignalToFFT(buffer); }
+
+    if (analysis != nullptr)
+        analysis->outputMeter.process(buffer);
+}
+
+/* Linear blend between the processed buffer and the allpassed dry copy. The two are in phase, so equal gain,
+   not equal power, keeps the level steady. Reuses the gain-curve buffer, which applyOutputStage has finished with by now */
+//==============================================================================
+template <typename SampleType>
+void TertiaryAudioProcessor::applyPassthroughCrossfade(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dry)
+{
+    using FVO = juce::FloatVectorOperations;
 
-    // Flag to update High LFO parameters
-    if (parameterChangedLfoHigh)
+    auto& chain = getChain<SampleType>();
+    auto numSamples = buffer.getNumSamples();
+    auto* wetCurve = chain.gainCurves.getWritePointer(0);
+    auto* dryCurve = chain.gainCurves.getWritePointer(1);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto mix = passthroughMix.getNextValue();
+        wetCurve[i] = (SampleType)(1.f - mix);
+        dryCurve[i] = (SampleType)mix;
+    }
+
+    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
     {
-        highLFO.updateLFO(sampleRate, hostInfo.bpm);
-        parameterChangedLfoHigh = false;
+        auto* out = buffer.getWritePointer(channel);
+
+        FVO::multiply(out, wetCurve, numSamples);
+        FVO::addWithMultiply(out, dry.getReadPointer(channel), dryCurve, numSamples);
     }
+}
+
+/* Housekeeping DURING audio processing */
+//==============================================================================
+void TertiaryAudioProcessor::updateState()
+{
+    /* Update Input & Output gain params*/
+    getChain<float>().inputGain.setGainDecibels(inputGainParam->get());
+    getChain<double>().inputGain.setGainDecibels(inputGainParam->get());
+    outputGain.setTargetValue(juce::Decibels::decibelsToGain(outputGainParam->get()));
+
+    /* Update tremolo effect params */
+    for (auto& trem : tremolos)
+        trem.updateTremoloSettings();
 
+    // Pick up LFO parameter changes flagged since the last block. Depth, symmetry and invert then glide at read time
+    const auto changed = parameterDispatcher.consume();
+    const std::array<LFO*, numBands> lfos { &lowLFO, &midLFO, &highLFO };
 
-    // Update Crossover Params
-    LP1.setCutoffFrequency(lowMidCrossover->get());
-    HP1.setCutoffFrequency(lowMidCrossover->get());
-    AP2.setCutoffFrequency(midHighCrossover->get());
-    LP2.setCutoffFrequency(midHighCrossover->get());
-    HP2.setCutoffFrequency(midHighCrossover->get());
+    for (int band = 0; band < (int)lfos.size(); ++band)
+    {
+        if (changed & lfoShapeChanged(band))
+            lfos[(size_t)band]->updateShape();
+
+        if (changed & lfoTimingChanged(band))
+            lfos[(size_t)band]->updateTempo(hostInfo.bpm);
+    }
+
+
+    // Update Crossover Params. Both engines skip unchanged values, so this is free while idle.
+    // The linear-phase kernels are only redesigned while that engine is in use
+    getChain<float>().crossover.setCrossoverFrequency(0, lowMidCrossover->get());
+    getChain<float>().crossover.setCrossoverFrequency(1, midHighCrossover->get());
+    getChain<double>().crossover.setCrossoverFrequency(0, lowMidCrossover->get());
+    getChain<double>().crossover.setCrossoverFrequency(1, midHighCrossover->get());
+
+    setCrossoverMode(crossoverModeParam->getIndex() == 1);
+
+    if (linearPhaseActive)
+    {
+        linearPhaseCrossover.setCrossoverFrequency(0, lowMidCrossover->get());
+        linearPhaseCrossover.setCrossoverFrequency(1, midHighCrossover->get());
+    }
 
     /* Sometimes when multiplier param is changed, LFOs become out of sync with each
        other or out-of-sync with the host grid.  The following detects Multiplier
@@ -827,189 +1185,127 @@ void TertiaryAudioProcessor::updateState()
 
 /* Updates FFT information for FrequencyResponse Module */
 //==============================================================================
-void TertiaryAudioProcessor::pushSignalToFFT (juce::AudioBuffer<float> &buffer)
+template <typename SampleType>
+void TertiaryAudioProcessor::pushSignalToFFT (juce::AudioBuffer<SampleType> &buffer)
 {
-    for (int i = 0; i < buffer.getNumSamples(); i++)
-    {
-        float sample = 0.f;
-
-        for (int channel = 0; channel < buffer.getNumChannels(); channel++)
-        {
-            sample += buffer.getSample(channel, i) / 2.f;
-        }
-
-        pushNextSampleIntoFifo(sample);
-    }
+    if (analysis != nullptr && analysis->spectrumAnalyzer.isTraceActive(mixTrace))
+        analysis->mixFeed.push(buffer);
 }
 
-/* Pulls RMS audio levels from ProcessBlock and updates the Input and Output meters. */
+/* Applies the amplitude modulation, band gains, solo/mute and output gain, and re-sums the bands.
+   Everything that scales a band is first folded into one gain curve per band, so the
+   band buffers are each read exactly once and the output is written in a single pass */
 //==============================================================================
-void TertiaryAudioProcessor::updateMeterLevels ( juce::LinearSmoothedValue<float> &left,
-                                                 juce::LinearSmoothedValue<float> &right,
-                                                 juce::AudioBuffer<float> &buffer)
+template <typename SampleType>
+void TertiaryAudioProcessor::applyOutputStage(juce::AudioBuffer<SampleType>& buffer)
 {
-    auto totalNumSamples = buffer.getNumSamples();
-    
-    left.skip(totalNumSamples);
-    
-    const auto newValueLeft = juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, 0, buffer.getNumSamples()));
-    
-    /* If value is ascending, we use instantatneous value.
-       If value is descending, we smooth value on its way down. */
-    
-    if (newValueLeft < left.getCurrentValue())
-        left.setTargetValue(newValueLeft);
-    else left.setCurrentAndTargetValue(newValueLeft);
+    using FVO = juce::FloatVectorOperations;
 
+    auto& gainCurves = getChain<SampleType>().gainCurves;
+    auto numChannels = buffer.getNumChannels();
+    auto numSamples = buffer.getNumSamples();
+    auto maxChunkSize = gainCurves.getNumSamples();
 
-    /* If Stereo, do the same to the right */
-    if (getTotalNumInputChannels() > 1)
-    {
-        right.skip(totalNumSamples);
+    if (maxChunkSize == 0)
+        return;
 
-        const auto newValueRight = juce::Decibels::gainToDecibels(buffer.getRMSLevel(1, 0, buffer.getNumSamples()));
+    std::array<LFO*, numBands> lfos { &lowLFO, &midLFO, &highLFO };
 
-        /* If value is ascending, we use instantatneous value.
-        If value is descending, we smooth value on its way down. */
+    /* Read Bypass, Solo and Mute once per block */
+    std::array<bool, numBands> bandIsBypassed, bandIsAudible, bandIsAnalysed;
 
-        if (newValueRight < right.getCurrentValue())
-            right.setTargetValue(newValueRight);
-        else right.setCurrentAndTargetValue(newValueRight);
-    }
-    else
-        right = left;
+    for (size_t band = 0; band < (size_t)numBands; ++band)
+    {
+        bandIsBypassed[band] = tremolos[band].bypassParam->get();
+        bandIsAudible[band] = isBandAudible((int)band);
+        bandIsAnalysed[band] = bandIsAudible[band] && isBandAnalysed((int)band);
     }
 
-/* Applies the three-way crossover to the incoming audio signal */
-//==============================================================================
-void TertiaryAudioProcessor::applyCrossover(const juce::AudioBuffer<float>& inputBuffer)
-{
-    /* See PDF for signal-flow diagram */
-    
-    // Copy incoming audio into all filter buffers
-    for (auto& fb : filterBuffers)
-        fb = inputBuffer;
+    /* Process in chunks no larger than the prepared gain-curve buffer */
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        auto chunkSize = juce::jmin(maxChunkSize, numSamples - start);
 
-    auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);     // Create audio block for the buffer containing LOWS
-    auto fb1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);     // Create audio block for the buffer containing MIDS
-    auto fb2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);     // Create audio block for the buffer containing HIGHS
+        /* Output Gain Curve */
+        auto* outputCurve = gainCurves.getWritePointer(numBands);
 
-    auto fb0Ctx = juce::dsp::ProcessContextReplacing<float>(fb0Block);  // Create a context for the block
-    auto fb1Ctx = juce::dsp::ProcessContextReplacing<float>(fb1Block);  // Create a context for the block
-    auto fb2Ctx = juce::dsp::ProcessContextReplacing<float>(fb2Block);  // Create a context for the block
+        if (outputGain.isSmoothing())
+            for (int i = 0; i < chunkSize; ++i) { outputCurve[i] = outputGain.getNextValue(); }
+        else
+            FVO::fill(outputCurve, outputGain.getTargetValue(), chunkSize);
 
-    LP1.process(fb0Ctx);                    // LP1 and AP2 create LOWS
-    AP2.process(fb0Ctx);                    // LP1 and AP2 create LOWS
+        /* Per-Band Gain Curves: LFO x Band Gain x Output Gain */
+        std::array<const SampleType*, numBands> sources, curves;
+        std::array<int, numBands> bandIndex;
+        int numAudible = 0;
 
-    HP1.process(fb1Ctx);                    // HP1 splits two ways: MIDS and HIGHS
-    filterBuffers[2] = filterBuffers[1];    // Make a copy before BPF, to prepare for HIGHS
-    LP2.process(fb1Ctx);                    // HP1 and LP2 create BPF
+        for (size_t band = 0; band < (size_t)numBands; ++band)
+        {
+            auto& trem = tremolos[band];
 
-    HP2.process(fb2Ctx);                    // HP1, and HP2 create HIGHS
-}
+            /* Inaudible bands keep their LFO and gain ramps running so they resume in place */
+            if (!bandIsAudible[band])
+            {
+                lfos[band]->advance(chunkSize);
+                trem.bandGain.skip(chunkSize);
+                continue;
+            }
 
-/* Applies the amplitude modulation to create the tremolo effect */
-//==============================================================================
-void TertiaryAudioProcessor::applyAmplitudeModulation()
-{
-    /* Apply Amplitude Modulation */
-    for (int sample = 0; sample < filterBuffers[0].getNumSamples(); ++sample)
-    {
-        auto waveTableSize = lowLFO.getWaveTableSize();
-        auto totalNumInputChannels = getTotalNumInputChannels();
-        
-        /* Index = Current Position in the Given WaveTable.
-        Apply a single offset based on the Relative Phase Shift.*/
-        int lowIndex = fmod((lowLFO.getPosition() + lowLFO.getRelativePhaseInSamples()), (float)waveTableSize);
-        int midIndex = fmod((midLFO.getPosition() + midLFO.getRelativePhaseInSamples()), (float)waveTableSize);
-        int highIndex = fmod((highLFO.getPosition() + highLFO.getRelativePhaseInSamples()), (float)waveTableSize);
-
-        /* LFO Instantaneous Amplitude, usd to Modulate Input Signal */
-        float mGainLowLFO = lowLFO.getWaveTableScaled()[lowIndex];
-        float mGainMidLFO = midLFO.getWaveTableScaled()[midIndex];
-        float mGainHighLFO = highLFO.getWaveTableScaled()[highIndex];
-
-        /* Update the LFO's Instantaneous Position */
-        lowLFO.setPosition( fmod((lowLFO.getPosition() + lowLFO.getIncrement()), waveTableSize) );
-        midLFO.setPosition( fmod((midLFO.getPosition() + midLFO.getIncrement()), waveTableSize) );
-        highLFO.setPosition( fmod((highLFO.getPosition() + highLFO.getIncrement()), waveTableSize) );
-
-        /* Amplitude Modulation on Lows */
-        if (!lowBandTrem.bypassParam->get())
-        {
-            for (int i = 0; i < totalNumInputChannels; i++) {
-                filterBuffers[0].getWritePointer(i)[sample] *= mGainLowLFO; }
-        }
+            auto* curve = gainCurves.getWritePointer((int)band);
 
-        /* Amplitude Modulation on Mids */
-        if (!midBandTrem.bypassParam->get())
-        {
-            for (int i = 0; i < totalNumInputChannels; i++) {
-                filterBuffers[1].getWritePointer(i)[sample] *= mGainMidLFO; }
-        }
+            /* Bypassed bands keep their LFO running so they stay in phase */
+            if (bandIsBypassed[band])
+            {
+                lfos[band]->advance(chunkSize);
+                FVO::copy(curve, outputCurve, chunkSize);
+            }
+            else
+            {
+                lfos[band]->renderBlock(curve, chunkSize);
+                FVO::multiply(curve, outputCurve, chunkSize);
+            }
 
-        /* Amplitude Modulation on Highs */
-        if (!highBandTrem.bypassParam->get())
-        {
-            for (int i = 0; i < totalNumInputChannels; i++)    {
-                filterBuffers[2].getWritePointer(i)[sample] *= mGainHighLFO; }
-        }
-    }
-}
+            if (trem.bandGain.isSmoothing())
+                for (int i = 0; i < chunkSize; ++i) { curve[i] *= trem.bandGain.getNextValue(); }
+            else
+                FVO::multiply(curve, trem.bandGain.getTargetValue(), chunkSize);
 
-/* Checks for Bypass, Solo, Mute and re-sums audio bands appropriately */
-//==============================================================================
-void TertiaryAudioProcessor::sumAudioBands(juce::AudioBuffer<float>& buffer)
-{
-    using namespace juce;
-    
-    /* Clear the Input Buffer */
-    buffer.clear();
-    
-    /* Helper function to add filter bands back into audio path */
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
-    
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
-    {
-        for (auto i = 0; i < nc; ++i)
-        {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
-    };
+            curves[numAudible] = curve;
+            bandIndex[numAudible] = (int)band;
+            ++numAudible;
 
-    /* Check if any bands are solo'ed */
-    auto bandsAreSoloed = false;
-    for (auto& trem : tremolos)
-    {
-        if (trem.soloParam->get())
-        {
-            bandsAreSoloed = true;
-            break;
+            /* Band Spectrum: the band as heard, one bulk write per block */
+            if (bandIsAnalysed[band])
+                analysis->getBandFeed((int)band).push(getCrossoverBand<SampleType>((int)band), start, chunkSize, curve);
         }
-    }
 
-    /* If any bands are solo'ed, only add those back to the audio path */
-    if (bandsAreSoloed)
-    {
-        for (size_t i = 0; i < tremolos.size(); ++i)
-        {
-            auto& trem = tremolos[i];
-            if (trem.soloParam->get())
-            {
-                addFilterBand(buffer, filterBuffers[i]);
-            }
-        }
-    }
-    else
-    /* Otherwise add everything except for those which are muted */
-    {
-        for (size_t i = 0; i < tremolos.size(); ++i)
+        /* Single pass over each output channel */
+        for (int channel = 0; channel < numChannels; ++channel)
         {
-            auto& trem = tremolos[i];
-            if (!trem.muteParam->get())
+            auto* out = buffer.getWritePointer(channel, start);
+
+            for (int i = 0; i < numAudible; ++i)
+                sources[i] = getCrossoverBand<SampleType>(bandIndex[i]).getReadPointer(channel, start);
+
+            switch (numAudible)
             {
-                addFilterBand(buffer, filterBuffers[i]);
+                case 0:
+                    FVO::clear(out, chunkSize);
+                    break;
+
+                case 1:
+                    FVO::multiply(out, sources[0], curves[0], chunkSize);
+                    break;
+
+                case 2:
+                    for (int i = 0; i < chunkSize; ++i)
+                        out[i] = sources[0][i] * curves[0][i] + sources[1][i] * curves[1][i];
+                    break;
+
+                default:
+                    for (int i = 0; i < chunkSize; ++i)
+                        out[i] = sources[0][i] * curves[0][i] + sources[1][i] * curves[1][i] + sources[2][i] * curves[2][i];
+                    break;
             }
         }
     }
@@ -1062,7 +1358,26 @@ bool TertiaryAudioProcessor::isMidiEffect() const
 }
 
 //==============================================================================
-double TertiaryAudioProcessor::getTailLengthSeconds() const { return 0.0; }
+/* How long the output keeps ringing after the input stops, for the current crossover settings */
+double TertiaryAudioProcessor::getTailLengthSeconds() const
+{
+    auto sampleRate = getSampleRate();
+
+    if (sampleRate <= 0.0)
+        return 0.0;
+
+    /* Linear phase: the full kernel, which includes the reported latency */
+    if (linearPhaseActive)
+        return linearPhaseCrossover.getKernelSize() / sampleRate;
+
+    /* Linkwitz-Riley: the Butterworth sections decay at w0 / sqrt(2), so the lowest crossover rings longest.
+       Two cascaded sections decay somewhat slower than one, hence the factor of two */
+    auto lowestCrossover = (double)juce::jmin(lowMidCrossover->get(), midHighCrossover->get());
+    auto decayTime = std::log(1.0 / silenceThreshold) * juce::MathConstants<double>::sqrt2
+                   / (juce::MathConstants<double>::twoPi * lowestCrossover);
+
+    return 2.0 * decayTime;
+}
 
 //==============================================================================
 int TertiaryAudioProcessor::getNumPrograms() { return 1; }
@@ -1093,12 +1408,11 @@ bool TertiaryAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout from mono up to 16 channels (7.1.4, 9.1.6, discrete...).
+    // The crossover filters channels in SIMD lanes, so wide layouts stay cheap.
+    auto numChannels = layouts.getMainOutputChannelSet().size();
+
+    if (numChannels < 1 || numChannels > maxNumChannels)
         return false;
 
     // This checks if the input layout matches the output layout
@@ -1129,50 +1443,3 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new TertiaryAudioProcessor();
 }
-
-
-/* Parameter Changed Callback */
-//==============================================================================
-void TertiaryAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
-{
-    using namespace juce;
-    using namespace Params;
-    const auto& params = GetParams();
-
-    // Flag for updates to Low LFO
-    if (parameterID == params.at(Wave_Low_LFO) ||
-        parameterID == params.at(Symmetry_Low_LFO) ||
-        parameterID == params.at(Depth_Low_LFO) ||
-        parameterID == params.at(Rate_Low_LFO) ||
-        parameterID == params.at(Multiplier_Low_LFO) ||
-        parameterID == params.at(Relative_Phase_Low_LFO) ||
-        parameterID == params.at(Invert_Low_LFO))
-    {
-        parameterChangedLfoLow = true;
-    }
-      
-    // Flag for updates to Mid LFO
-    if (parameterID == params.at(Wave_Mid_LFO) ||
-        parameterID == params.at(Symmetry_Mid_LFO) ||
-        parameterID == params.at(Depth_Mid_LFO) ||
-        parameterID == params.at(Rate_Mid_LFO) ||
-        parameterID == params.at(Multiplier_Mid_LFO) ||
-        parameterID == params.at(Relative_Phase_Mid_LFO) ||
-        parameterID == params.at(Invert_Mid_LFO))
-    {
-        parameterChangedLfoMid = true;
-    }
-
-    // Flag for updates to High LFO
-    if (parameterID == params.at(Wave_High_LFO) ||
-        parameterID == params.at(Symmetry_High_LFO) ||
-        parameterID == params.at(Depth_High_LFO) ||
-        parameterID == params.at(Rate_High_LFO) ||
-        parameterID == params.at(Multiplier_High_LFO) ||
-        parameterID == params.at(Relative_Phase_High_LFO) ||
-        parameterID == params.at(Invert_High_LFO))
-    {
-        parameterChangedLfoHigh = true;
-    }
-
-}
@@ -5,6 +5,10 @@
 #include <JuceHeader.h>
 #include "DSP/Params.h"
 #include "DSP/LFO.h"
+#include "DSP/BandSplitter.h"
+#include "DSP/LinearPhaseCrossover.h"
+#include "DSP/ParameterDispatcher.h"
+#include "DSP/AnalysisHost.h"
 
 /* Audio-Path-Wrapper holding the parameters unique to the multiple effect bands */
 struct TremoloBand
@@ -17,20 +21,35 @@ struct TremoloBand
 
     juce::AudioParameterFloat* bandGainParam{ nullptr };
 
-    juce::dsp::Gain<float> bandGain;
+    juce::SmoothedValue<float> bandGain;    // Linear gain, applied inside the fused output stage
+
+    void prepare(double sampleRate)
+    {
+        bandGain.reset(sampleRate, 0.05);                                                   // Reduce Artifacts
+        bandGain.setCurrentAndTargetValue(juce::Decibels::decibelsToGain(bandGainParam->get()));
+    }
 
     void updateTremoloSettings()
     {
-        bandGain.setRampDurationSeconds(0.05);              // Reduce Artifacts
-        bandGain.setGainDecibels(bandGainParam->get());     // Update Gain
+        bandGain.setTargetValue(juce::Decibels::decibelsToGain(bandGainParam->get()));     // Update Gain
     }
 
 };
 
+/* Everything in the signal chain whose state depends on the sample type.
+   The processor holds one for each precision, and only prepares the one the host uses */
+template <typename SampleType>
+struct SignalChain
+{
+    BandSplitter<SampleType> crossover;                 // Splits the input into the band buffers
+    juce::dsp::Gain<SampleType> inputGain;
+    juce::AudioBuffer<SampleType> gainCurves;           // Per-band combined gain for the current block, plus the output gain curve
+    juce::AudioBuffer<SampleType> passthroughBuffer;    // Dry input, allpassed by the crossover, only filled while crossfading
+};
+
 //==============================================================================
 
-class TertiaryAudioProcessor  : public juce::AudioProcessor,
-                                public juce::AudioProcessorValueTreeState::Listener
+class TertiaryAudioProcessor  : public juce::AudioProcessor
 {
 public:
     //==============================================================================
@@ -49,6 +68,15 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
+    static constexpr int maxNumChannels = 16;
+
+    /* Parameters are latched once per sub-block, so this bounds the automation granularity.
+       Set by the Sub-Block Size param, read once per host block */
+    static constexpr int minSubBlockSize = 16, maxSubBlockSize = 256;
+    int getSubBlockSize() const { return minSubBlockSize << subBlockSizeParam->getIndex(); }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -77,8 +105,6 @@ public:
     using APVTS = juce::AudioProcessorValueTreeState;       // Alias
     static APVTS::ParameterLayout createParameterLayout();  // Parameter Layout Function
 
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
-
 	void setFftPickoffPoint(int point);
 
     APVTS apvts{    *this,                                  // Audio Processor
@@ -97,10 +123,12 @@ public:
 
     juce::AudioParameterBool* getShowFftParam() {return showFftParam;}
     juce::AudioParameterChoice* getFftPickofIdParam() { return fftPickoffParam; }
+    juce::AudioParameterBool* getShowBandFftParam() { return showBandFftParam; }
     
     /* Input & Output Meters */
     // =========================================================================
-    float getRmsValue(const int pickOffPoint, const int channel) const;
+    /* Latest levels at the input (0) or output (1), or silence while nothing is attached. Message thread */
+    LevelMeter::Snapshot getMeterSnapshot(const int pickOffPoint) const;
 
     /* LFO */
     // =========================================================================
@@ -113,33 +141,67 @@ public:
 
 	/* Frequency Response */
     // =========================================================================
-    void pushNextSampleIntoFifo(float sample);
-    
     enum
     {
-        fftOrder = 12,
-        fftSize = 1 << fftOrder,
         scopeSize = 512
     };
     
-    float fifo[fftSize];
-    float fftData[2 * fftSize];
-    float scopeData[scopeSize];
-    bool nextFFTBlockReady = false;
-    int fifoIndex = 0;
+    /* The plugin runs three bands. BandSplitter and LinearPhaseCrossover take any count from 2 to 8, but the
+       params, LFOs, band feeds and controls are still one named set per band, so the count is fixed here */
+    static constexpr int numBands = 3;
+
+    /* One trace for the full signal at the pickoff point, then one per band after modulation */
+    enum SpectrumTrace { mixTrace, lowBandTrace, midBandTrace, highBandTrace };
+    static constexpr int bandTrace(int band) { return lowBandTrace + band; }
+
+    /* Meters and spectrum analyzer, only allocated while a Consumer is attached. The editor attaches one */
+    AnalysisHost analysisHost{ scopeSize };
+
+    /* The analyzer settings selected by the FFT Size, Window, Overlap and Zero Padding params. Any thread */
+    SpectrumAnalyzer::Settings getAnalyzerSettings() const;
+
+    /* Whether a band is heard, given every band's Solo and Mute */
+    bool isBandAudible(int band) const;
     
 
 private:
 
-    
-    bool parameterChangedLfoLow{true};
-    bool parameterChangedLfoMid{true};
-    bool parameterChangedLfoHigh{true};
+
+    /* Parameter Change Dispatch */
+    // =========================================================================
+    ParameterDispatcher parameterDispatcher;    // Flags LFO parameter changes for updateState()
+
+    static constexpr ParameterDispatcher::Mask lfoShapeChanged(int band) { return ParameterDispatcher::Mask(1) << band; }
+    static constexpr ParameterDispatcher::Mask lfoTimingChanged(int band) { return ParameterDispatcher::Mask(1) << (numBands + band); }
     
     
     /* Main DSP */
-    void applyAmplitudeModulation();
-    void sumAudioBands(juce::AudioBuffer<float>& buffer);
+    template <typename SampleType> void processBlockInternal(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void processSubBlock(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void applyOutputStage(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void prepareChain(SignalChain<SampleType>& chain, const juce::dsp::ProcessSpec& spec);
+
+    std::tuple<SignalChain<float>, SignalChain<double>> signalChains;
+
+    template <typename SampleType>
+    SignalChain<SampleType>& getChain() { return std::get<SignalChain<SampleType>>(signalChains); }
+
+    /* Silence Detection */
+    // =========================================================================
+    template <typename SampleType> bool updateIdleState(const juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void processIdle(juce::AudioBuffer<SampleType>& buffer);
+    bool isIdle{ false };
+    int silentSamples{ 0 };                 // Consecutive input samples below silenceThreshold
+    static constexpr float silenceThreshold = 1.0e-5f;   // -100 dBFS
+
+    /* Passthrough */
+    // =========================================================================
+    bool isTransparent() const;
+    template <typename SampleType> void processPassthrough(juce::AudioBuffer<SampleType>& buffer);
+    template <typename SampleType> void applyPassthroughCrossfade(juce::AudioBuffer<SampleType>& buffer, const juce::AudioBuffer<SampleType>& dry);
+    juce::SmoothedValue<float> passthroughMix;      // 0 = processed, 1 = allpassed input
+    bool passthroughTarget{ false };                // Where passthroughMix heads once settled
+    int passthroughSettleSamples{ 0 };              // Both paths run, unmixed, until this reaches zero
     
     
     void updateState();			// Process Block, Update State
@@ -163,7 +225,7 @@ private:
     /* FrequencyResponse */
     // =========================================================================
     bool fftPickoffPointIsInput{ false };
-    void pushSignalToFFT (juce::AudioBuffer<float> &buffer);
+    template <typename SampleType> void pushSignalToFFT (juce::AudioBuffer<SampleType> &buffer);
     
     /* BPM and Host Info */
     // =========================================================================
@@ -173,15 +235,24 @@ private:
     
     /* Crossover */
     // =========================================================================
-    void applyCrossover(const juce::AudioBuffer<float>& inputBuffer);    // Crossover Function
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    Filter  LP1, AP2, HP1, LP2, HP2;
+    LinearPhaseCrossover linearPhaseCrossover;      // Alternative to the chain's crossover, selected by the Crossover Mode param
+    bool linearPhaseActive{ false };
+    void setCrossoverMode(bool useLinearPhase);
+    void setEngineLatency(int numSamples);
+    void resetCrossovers();
+
+    template <typename SampleType>
+    juce::AudioBuffer<SampleType>& getCrossoverBand(int band)
+    {
+        return linearPhaseActive ? linearPhaseCrossover.getBand<SampleType>(band) : getChain<SampleType>().crossover.getBand(band);
+    }
     juce::AudioParameterFloat* lowMidCrossover{ nullptr };  // Pointer to the APVTS
     juce::AudioParameterFloat* midHighCrossover{ nullptr }; // Pointer to the APVTS
+    juce::AudioParameterChoice* crossoverModeParam{ nullptr }; // Pointer to the APVTS
     
     /* Input & Output Gain */
     // =========================================================================
-    juce::dsp::Gain<float> inputGain, outputGain;
+    juce::SmoothedValue<float> outputGain;      // Folded into the band gain curves by applyOutputStage
     juce::AudioParameterFloat* inputGainParam{ nullptr };               // Pointer to the APVTS
     juce::AudioParameterFloat* outputGainParam{ nullptr };              // Pointer to the APVTS
     
@@ -196,28 +267,34 @@ private:
 
     juce::AudioParameterBool* showFftParam{ nullptr };
     juce::AudioParameterChoice* fftPickoffParam{ nullptr };     
+    juce::AudioParameterBool* showBandFftParam{ nullptr };
+    juce::AudioParameterChoice* fftSizeParam{ nullptr };
+    juce::AudioParameterChoice* fftWindowParam{ nullptr };
+    juce::AudioParameterChoice* fftOverlapParam{ nullptr };
+    juce::AudioParameterChoice* fftZeroPaddingParam{ nullptr };
 
-    /* Input & Output Meters */
+    juce::AudioParameterChoice* subBlockSizeParam{ nullptr };  // Engine granularity, see getSubBlockSize()
+
+    /* Analysis */
     // =========================================================================
-    juce::LinearSmoothedValue<float> rmsLevelInputLeft, rmsLevelInputRight, rmsLevelOutputLeft, rmsLevelOutputRight;
-    void updateMeterLevels ( juce::LinearSmoothedValue<float> &left, juce::LinearSmoothedValue<float> &right, juce::AudioBuffer<float> &buffer);
+    AnalysisState* analysis{ nullptr };     // Audio thread. Published state for the current block, or nullptr when nothing is attached
+    bool isBandAnalysed(int band) const;
     
     // Function to apply input/output gain
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
+    template<typename SampleType, typename U>
+    void applyGain(juce::AudioBuffer<SampleType>& buffer, U& gain)
     {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        auto block = juce::dsp::AudioBlock<SampleType>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
         gain.process(ctx);
     }
     
     /* Tremolo-Bands */
     // =========================================================================
-    std::array<TremoloBand, 3> tremolos;        // Array of param-wrappers containing byp/mute/solo for each band
+    std::array<TremoloBand, numBands> tremolos; // Array of param-wrappers containing byp/mute/solo for each band
     TremoloBand& lowBandTrem = tremolos[0];     // Low Band
     TremoloBand& midBandTrem = tremolos[1];     // Mid Band
     TremoloBand& highBandTrem = tremolos[2];    // High Band
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;  // An array of 3 buffers which contain the filtered audio
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TertiaryAudioProcessor)
 };